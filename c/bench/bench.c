@@ -0,0 +1,281 @@
+/**
+    * @file bench.c
+    * @brief Benchmarks for flameysutils.h. Prints the results as JSON to the standard output.
+    *
+    *        Usage: bench [max size] [min time per case in milliseconds]
+    *           Sizes go from 16 up to `max size` (1 million by default, up to 100 million).
+*/
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <flameysutils.h>
+
+#define DISTRIBUTIONS 4
+
+const char* distribution_names[DISTRIBUTIONS] = { "random", "sorted", "reversed", "few-unique" };
+
+const size_t sizes[] = { 16, 256, 4096, 65536, 1048576, 16777216, 100000000 };
+
+size_t max_size = 1048576;
+double min_time = 0.05;
+bool first_result = true;
+
+/**
+    * @brief Gets the current time, in seconds.
+*/
+double now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+/**
+    * @brief Fills an array following one of the distributions.
+    *
+    * @param array The array to fill.
+    * @param size Number of elements.
+    * @param distribution Index in `distribution_names`.
+*/
+void fill
+(
+    int array[],
+    size_t size,
+    int distribution
+)
+{
+    switch (distribution)
+    {
+        case 0:
+            randints(array, 0, size - 1, 0, RAND_MAX - 1);
+            break;
+        case 1:
+            for (size_t i = 0; i < size; i++) array[i] = i;
+            break;
+        case 2:
+            for (size_t i = 0; i < size; i++) array[i] = size - i;
+            break;
+        default:
+            randints(array, 0, size - 1, 0, 7);
+            break;
+    }
+}
+
+/**
+    * @brief Writes one result as a JSON object.
+    *
+    * @param name Name of the benchmark.
+    * @param distribution Index in `distribution_names`, or -1 if the benchmark doesn't depend on the data.
+    * @param size Number of elements processed per repetition.
+    * @param seconds Total time spent in the measured code.
+    * @param repetitions Number of repetitions.
+*/
+void report
+(
+    const char* name,
+    int distribution,
+    size_t size,
+    double seconds,
+    size_t repetitions
+)
+{
+    double elements = (double) size * repetitions;
+
+    printf("%s\n    {\"benchmark\": \"%s\", \"distribution\": \"%s\", \"size\": %zu, \"repetitions\": %zu, \"ns_per_element\": %.3f, \"elements_per_second\": %.0f, \"megabytes_per_second\": %.1f}",
+        first_result ? "" : ",", name, distribution < 0 ? "none" : distribution_names[distribution], size, repetitions,
+        seconds * 1e9 / elements, elements / seconds, elements * sizeof(int) / seconds / 1e6);
+    fflush(stdout);
+
+    first_result = false;
+}
+
+/**
+    * @brief Redirects the standard output to `/dev/null` while printing benchmarks run.
+    *
+    * @param silence `true` to start redirecting, `false` to stop.
+*/
+void silence_stdout(bool silence)
+{
+    static int saved = -1;
+
+    fflush(stdout);
+
+    if (silence)
+    {
+        int null = open("/dev/null", O_WRONLY);
+
+        saved = dup(STDOUT_FILENO);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+    else
+    {
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+}
+
+/**
+    * @brief Runs one operation on a fresh copy of the source data until `min_time` is reached, adding up the time in `seconds`.
+    *           Copying the source data isn't counted.
+*/
+#define measure(seconds, repetitions, source, work, size, operation) ( \
+{ \
+    while (seconds < min_time) \
+    { \
+        memcpy(work, source, size * sizeof(int)); \
+        \
+        double begin = now(); \
+        operation; \
+        seconds += now() - begin; \
+        repetitions++; \
+    } \
+})
+
+/**
+    * @brief Times one operation with `measure()`, then reports it.
+*/
+#define timed(name, distribution, source, work, size, operation) ( \
+{ \
+    double seconds = 0; \
+    size_t repetitions = 0; \
+    \
+    measure(seconds, repetitions, source, work, size, operation); \
+    report(name, distribution, size, seconds, repetitions); \
+})
+
+/**
+    * @brief Times one of the input functions, reading `size` integers from a pipe written by a child process.
+*/
+void bench_input(int work[], size_t size)
+{
+    double seconds = 0;
+    size_t repetitions = 0;
+
+    while (seconds < min_time)
+    {
+        int pipefd[2];
+
+        if (pipe(pipefd) != 0) return;
+
+        pid_t child = fork();
+
+        if (child == 0)
+        {
+            FILE* writer = fdopen(pipefd[1], "w");
+
+            close(pipefd[0]);
+
+            for (size_t i = 0; i < size; i++) fprintf(writer, "%zu\n", i * 7919 % 100000);
+
+            fclose(writer);
+            _exit(0);
+        }
+
+        int saved = dup(STDIN_FILENO);
+
+        close(pipefd[1]);
+        dup2(pipefd[0], STDIN_FILENO);
+        close(pipefd[0]);
+        clearerr(stdin);
+
+        silence_stdout(true);
+
+        double begin = now();
+        arrinput("", "", "%d", work, sizeof(int), 0, size - 1, true);
+        seconds += now() - begin;
+
+        silence_stdout(false);
+
+        dup2(saved, STDIN_FILENO);
+        close(saved);
+        clearerr(stdin);
+        waitpid(child, nullptr, 0);
+
+        repetitions++;
+    }
+
+    report("arrinput", -1, size, seconds, repetitions);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) max_size = strtoull(argv[1], nullptr, 10);
+    if (argc > 2) min_time = atof(argv[2]) / 1000;
+
+    size_t largest = 0;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= max_size; s++) largest = sizes[s];
+
+    int* source = malloc(largest * sizeof(int));
+    int* work = malloc(largest * sizeof(int));
+    size_t* offsets = malloc((largest / 16 + 1) * sizeof(size_t));
+
+    if (largest == 0 || source == nullptr || work == nullptr || offsets == nullptr)
+    {
+        fprintf(stderr, "bench: the max size must be at least 16, and there must be enough memory for it.\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("[");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= max_size; s++)
+    {
+        size_t size = sizes[s];
+        size_t end = size - 1;
+        size_t segments = size / 16;
+
+        for (size_t k = 0; k <= segments; k++) offsets[k] = k * 16;
+
+        fill(source, size, 0);
+
+        timed("randints", -1, source, work, size, randints(work, 0, end, 0, 1000));
+        timed("shuffle", -1, source, work, size, shuffle(work, 0, end));
+
+        for (int d = 0; d < DISTRIBUTIONS; d++)
+        {
+            fill(source, size, d);
+
+            timed("qsort", d, source, work, size, qsort(work, 0, end, ascending));
+            timed("sort", d, source, work, size, sort(work, 0, end, ascending));
+            timed("segsort", d, source, work, size, segsort(work, offsets, segments, ascending));
+
+            if (size <= 4096)
+            {
+                timed("bsort", d, source, work, size, bsort(work, 0, end, ascending));
+                timed("gsort", d, source, work, size, gsort(work, 0, end, ascending));
+            }
+
+            timed("average", d, source, work, size, ({ volatile long double result = average(work, 0, end); (void) result; }));
+            timed("min", d, source, work, size, ({ volatile int result = min(work, 0, end); (void) result; }));
+            timed("max", d, source, work, size, ({ volatile int result = max(work, 0, end); (void) result; }));
+            timed("med", d, source, work, size, ({ volatile int result = med(work, 0, end); (void) result; }));
+        }
+
+        if (size <= 1048576)
+        {
+            fill(source, size, 0);
+
+            double seconds = 0;
+            size_t repetitions = 0;
+
+            silence_stdout(true);
+            measure(seconds, repetitions, source, work, size, printarr(work, "%d", 0, end));
+            silence_stdout(false);
+
+            report("printarr", 0, size, seconds, repetitions);
+
+            bench_input(work, size);
+        }
+    }
+
+    printf("\n]\n");
+
+    free(source);
+    free(work);
+    free(offsets);
+
+    return 0;
+}
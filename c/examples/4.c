@@ -0,0 +1,24 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <flameysutils.h>
+
+int main()
+{
+    int scores[] = { 7, 3, 9,   4, 1,   8, 6, 2, 5 };
+    size_t offsets[] = { 0, 3, 5, 9 };
+    int (*order)(const void*, const void*) = descending;
+
+    segsort(scores, offsets, 3, ascending);
+
+    printf("Each team, lowest first: ");
+    printarr(scores, "%d", 0, 8);
+
+    segsort(scores, offsets, 3, order);
+
+    printf("\nEach team, highest first: ");
+    printarr(scores, "%d", 0, 8);
+
+    printf("\n");
+
+    return 0;
+}
@@ -0,0 +1,7 @@
+/**
+    * @file flameysutils.c
+    * @brief Compiles the functions of `flameysutils.h` into a library. See the `Makefile`.
+*/
+
+#define FLAMEY_IMPLEMENTATION
+#include "flameysutils.h"
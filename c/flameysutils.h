@@ -6,6 +6,40 @@
     * @date 2025
 */
 
+/*
+    This header can be used in two ways:
+        Header-only (default)   Just include it. Every function is compiled inside every file that includes it.
+        Library                 Define `FLAMEY_LIBRARY` before including it (or use `pkg-config --cflags --libs flameysutils`),
+                                then link with `-lflameysutils`. The library is built by `make` in this folder.
+    The library itself is compiled from `flameysutils.c`, which defines `FLAMEY_IMPLEMENTATION` before including this header.
+    Small functions used by the macros (`swap()`, `randint()`, `validarrcheck()`, ...) are always `static inline`.
+*/
+
+#ifndef FLAMEYSUTILS_H
+#define FLAMEYSUTILS_H
+
+#if defined(FLAMEY_IMPLEMENTATION)
+#define FLAMEY_DEF __attribute__((visibility("default")))
+#define FLAMEY_DATA __attribute__((visibility("default")))
+#define FLAMEY_DEFINE_FUNCTIONS
+#elif defined(FLAMEY_LIBRARY)
+#define FLAMEY_DEF extern
+#else
+#define FLAMEY_DEF static __attribute__((unused))
+#define FLAMEY_DATA __attribute__((weak))
+#define FLAMEY_DEFINE_FUNCTIONS
+#endif
+
+/*
+    Functions that call `libm` (`log()`, `exp()`, ...) use `FLAMEY_MATHDEF` instead of `FLAMEY_DEF`.
+    In header-only mode they are `static inline`, so they are only compiled if they are used, and other programs don't need `-lm`.
+*/
+#if defined(FLAMEY_IMPLEMENTATION) || defined(FLAMEY_LIBRARY)
+#define FLAMEY_MATHDEF FLAMEY_DEF
+#else
+#define FLAMEY_MATHDEF static inline __attribute__((unused))
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -13,12 +47,27 @@
 #include <time.h>
 #include <string.h>
 #include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(FLAMEY_INSTRUMENT_TIME) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
 
 /*
     MISCELLANEOUS UTILITIES
 */
 
 #define nullptr ((void*) 0)
+#define npos ((size_t) -1)
 
 /**
     * @brief Swaps the values of two variables.
@@ -27,15 +76,18 @@
     * @param b Pointer to the second variable.
     * @param size Size of the variables.
 */
-void swap(void* a, void* b, size_t size)
+static inline void swap(void* a, void* b, size_t size)
 {
-    void* swapper = malloc(size);
+    unsigned char swapper[64];
 
-    memcpy(swapper, b, size);
-    memcpy(b, a, size);
-    memcpy(a, swapper, size);
+    for (size_t done = 0; done < size; done += sizeof(swapper))
+    {
+        size_t chunk = size - done < sizeof(swapper) ? size - done : sizeof(swapper);
 
-    free(swapper);
+        memcpy(swapper, (char*) b + done, chunk);
+        memcpy((char*) b + done, (char*) a + done, chunk);
+        memcpy((char*) a + done, swapper, chunk);
+    }
 }
 
 /**
@@ -45,19 +97,68 @@ void swap(void* a, void* b, size_t size)
     * @param dest Pointer to the destination `va_list`.
     * @param ... Arguments to put inside the `va_list`.
 */
-void arghelper
+FLAMEY_DEF void arghelper
 (
     va_list* dest,
     ...
-)
-{
-    va_list args;
-    va_start(args, dest);
+);
 
-    va_copy(*dest, args);
+/*
+    How much checking `validarrcheck()` does can be chosen before including this header, by defining `FLAMEY_CHECKS` as one of these:
+        `FLAMEY_CHECKS_FULL`    Array indices are always checked at runtime (default).
+        `FLAMEY_CHECKS_DEBUG`   Array indices are only checked at runtime if `NDEBUG` isn't defined.
+        `FLAMEY_CHECKS_NONE`    Array indices are never checked at runtime.
+    Indices that are known at compile time are always checked at compile time, whatever the level.
 
-    va_end(args);
-}
+    By default, an invalid array makes the program exit. Define `FLAMEY_CHECKS_NOEXIT` to make the checked function do nothing instead:
+    the error code is then stored in `flamey_lasterror`.
+*/
+
+#define FLAMEY_CHECKS_NONE 0
+#define FLAMEY_CHECKS_DEBUG 1
+#define FLAMEY_CHECKS_FULL 2
+
+#ifndef FLAMEY_CHECKS
+#define FLAMEY_CHECKS FLAMEY_CHECKS_FULL
+#endif
+
+#if FLAMEY_CHECKS == FLAMEY_CHECKS_FULL || (FLAMEY_CHECKS == FLAMEY_CHECKS_DEBUG && !defined(NDEBUG))
+#define FLAMEY_RUNTIME_CHECKS 1
+#else
+#define FLAMEY_RUNTIME_CHECKS 0
+#endif
+
+#define FLAMEY_OK 0
+#define FLAMEY_EBADRANGE 1
+#define FLAMEY_ENULL 2
+#define FLAMEY_EBOUNDS 3
+
+/**
+    * @brief Error code of the last failed check (`FLAMEY_OK`, `FLAMEY_EBADRANGE`, `FLAMEY_ENULL` or `FLAMEY_EBOUNDS`).
+    *           Only set when `FLAMEY_CHECKS_NOEXIT` is defined.
+*/
+extern _Thread_local int flamey_lasterror;
+
+/**
+    * @brief Reports an invalid array, then exits unless `FLAMEY_CHECKS_NOEXIT` is defined.
+    *           Kept out of line so that the checks in hot loops don't carry any stdio code.
+    *
+    *        ### The average user should not use this: use `validarrcheck()` instead.
+    *
+    * @param error The error code.
+    * @param start The array index given as the start (the length, for `FLAMEY_EBOUNDS`).
+    * @param end The array index given as the end.
+    * @param funcname The calling function's name.
+    *
+    * @return `error`.
+*/
+FLAMEY_DEF __attribute__((cold, noinline)) int validarrfail
+(
+    int error,
+    size_t start,
+    size_t end,
+    const char* funcname
+);
 
 /**
     * @brief Checks if the given array indices are valid.
@@ -66,28 +167,382 @@ void arghelper
     * @param start The array index given as the start.
     * @param end The array index given as the end.
     * @param funcname The calling function's name.
+    *
+    * @return `FLAMEY_OK` if the indices are valid. Otherwise, exits, or returns the error code if `FLAMEY_CHECKS_NOEXIT` is defined.
 */
-void validarrcheck
+static inline int validarrcheck
 (
-    void* array,
+    const void* array,
     size_t start,
     size_t end,
     const char* funcname
 )
 {
-    if (start > end)
-    {
-        fprintf(stderr, "%s(): `start` must be less than or equal to `end`.\nExpected `start` to be <= %u, but it was %u.\n", funcname, end, start);
-        exit(EXIT_FAILURE);
+    if (__builtin_expect(start > end, 0)) return validarrfail(FLAMEY_EBADRANGE, start, end, funcname);
+    if (__builtin_expect(array == nullptr, 0)) return validarrfail(FLAMEY_ENULL, start, end, funcname);
+
+    return FLAMEY_OK;
+}
+
+/**
+    * @brief Checks at compile time that `start` <= `end`, if both are known at compile time. Does nothing otherwise.
+    *           `start` is compared as `start + 0 * end`, so that `-Wtype-limits` doesn't warn about every `0` start with an unsigned `end`.
+*/
+#define flamey_isconstexpr(x) (sizeof(int) == sizeof(*(8 ? ((void*) ((long) (x) * 0l)) : (int*) 8)))
+#define flamey_startafterend(start, end) ((start) + 0 * (end) > (end))
+#define staticarrcheck(start, end) \
+    ((void) sizeof(struct { _Static_assert(__builtin_choose_expr(flamey_isconstexpr(flamey_startafterend(start, end)), !flamey_startafterend(start, end), 1), \
+        "`start` must be less than or equal to `end`."); int unused; }))
+
+/**
+    * @brief Checks array indices at the level chosen by `FLAMEY_CHECKS`. This is what all functions and macros of this header use.
+    *
+    * @param array The array (or view) to run checks on. For views, `end` must also be less than their length.
+    * @param start The array index given as the start.
+    * @param end The array index given as the end.
+    * @param funcname The calling function's name.
+    *
+    * @return `true` if the caller can go on, `false` if it should do nothing.
+*/
+#if FLAMEY_RUNTIME_CHECKS
+#define arrcheck(array, start, end, funcname) \
+    (staticarrcheck(start, end), __builtin_expect(validarrcheck(flamey_arrptr(array), start, end, funcname) == FLAMEY_OK && flamey_viewbounds(array, end, funcname), 1))
+#else
+#define arrcheck(array, start, end, funcname) (staticarrcheck(start, end), true)
+#endif
+
+/*
+    ARRAY VIEWS
+*/
+
+/*
+    A view lets the array macros read every `stride` bytes of memory instead of every element of an array: one field of an array of structures,
+    one column of a matrix, one channel of interleaved samples... Views are made with `arrview()` and `fieldview()`, and given to the macros instead of an array,
+    with the same `start` and `end`: `average()`, `min()`, `max()`, `med()`, `imin()`, `imax()`, `imed()`, `printarr()`, `is_sorted()`, `binsearch()`,
+    `argsort()`, `qsort()`, `sort()`, `bitset_range()` and `bitset_compress()`. The sorting macros move the whole structures (the `stride` bytes around each value), not just the values.
+    `average()`, `min()` and `max()` of views of `int`, `long`, `long long`, `float` and `double` (and the unsigned versions) load a whole vector register
+    of values at a time from the strided addresses.
+*/
+
+/**
+    * @brief The type of a view of `type` values. Each use makes a different type: store views in `__auto_type` variables.
+    *
+    *        ### The average user should not use this: use `arrview()` and `fieldview()` instead.
+*/
+#define flamey_viewtype(type) \
+    struct { type* first; size_t stride; size_t offset; size_t length; }
+
+/**
+    * @brief Makes a view of `type` values that are `stride` bytes apart, like the fields of an array of structures or a column of a matrix.
+    *
+    *        Example:
+    *```c
+    *double matrix[100][8];
+    *
+    *__auto_type column = arrview(matrix, sizeof(matrix[0]), 3 * sizeof(double), 100, double);
+    *long double avg = average(column, 0, 99);
+    *```
+    *
+    * @param base Pointer to the first structure (or row, ...).
+    * @param stride Number of bytes from one structure to the next.
+    * @param offset Number of bytes from the start of a structure to its value.
+    * @param length Number of values, to check `end` against (`npos` to not check it).
+    * @param type Type of the values.
+    *
+    * @return The view.
+*/
+#define arrview(base, stride, offset, length, type) \
+    ((flamey_viewtype(type)) { (type*) ((char*) (base) + (offset)), stride, offset, length })
+
+/**
+    * @brief Makes a view of one field of an array of structures.
+    *
+    *        Example:
+    *```c
+    *struct trade { long long time; double price; int volume; } trades[1000];
+    *
+    *double highest = max(fieldview(trades, price), 0, 999);
+    *qsort(fieldview(trades, time), 0, 999, llong_ascending); // Sorts the trades by time.
+    *```
+    *
+    * @param array The array of structures. If it's an array (and not a pointer), its length is checked.
+    * @param member The field (ex.: `price`, `position.x`).
+    *
+    * @return The view.
+*/
+#define fieldview(array, member) \
+    arrview(&(array)[0], sizeof((array)[0]), offsetof(typeof((array)[0]), member), flamey_arrlen(array), typeof((array)[0].member))
+
+/**
+    * @brief Gets whether an array macro was given a view instead of an array.
+*/
+#define flamey_isview(array) (__builtin_classify_type(array) == 12)
+
+/**
+    * @brief These turn what was given to an array macro into a view or an array, so that both the view code and the array code of the macro compile.
+    *           Only the code for what was really given runs: the other one gets an empty view, or a pointer to the first value of the view.
+    *           `flamey_anyview()` doesn't need the type of the values, so it also works for `void*` arrays.
+*/
+#define flamey_anyview(array) __builtin_choose_expr(flamey_isview(array), (array), (flamey_viewtype(char)) { 0 })
+#define flamey_rawarray(array) __builtin_choose_expr(flamey_isview(array), (char*) nullptr, (array))
+#define flamey_asview(array) __builtin_choose_expr(flamey_isview(array), (array), (flamey_viewtype(typeof(flamey_rawarray(array)[0]))) { 0 })
+#define flamey_asarray(array) __builtin_choose_expr(flamey_isview(array), flamey_asview(array).first, (array))
+
+/**
+    * @brief Gets the value at index `i` of an array or a view, as an lvalue.
+*/
+#define flamey_at(array, i) \
+    __builtin_choose_expr(flamey_isview(array), \
+        *(typeof(flamey_asview(array).first)) ((char*) flamey_asview(array).first + (i) * flamey_asview(array).stride), \
+        flamey_rawarray(array)[i])
+
+/**
+    * @brief Checks that `end` is inside a view, if `array` is a view with a known length. Used by `arrcheck()`.
+*/
+#define flamey_viewbounds(array, end, funcname) \
+    (!flamey_isview(array) || (end) < flamey_anyview(array).length || validarrfail(FLAMEY_EBOUNDS, flamey_anyview(array).length, end, funcname) == FLAMEY_OK)
+
+#define flamey_arrptr(array) \
+    __builtin_choose_expr(flamey_isview(array), (const void*) flamey_anyview(array).first, (const void*) flamey_rawarray(array))
+
+/**
+    * @brief Size of the vectors of the gather kernels, in bytes: 32 with AVX2 (which can load values from 8 addresses in one instruction), 16 otherwise.
+*/
+#if defined(__AVX2__)
+#define FLAMEY_GATHER_BYTES 32
+#else
+#define FLAMEY_GATHER_BYTES 16
+#endif
+
+/**
+    * @brief Defines the gather kernels for views of one type of value: minimum and maximum of a range, a vector register at a time.
+    *           Each vector is filled from addresses `stride` bytes apart, then reduced like a contiguous one.
+    *
+    *        ### The average user should not use this: use `min()`, `max()` and `average()` with a view instead.
+    *
+    * @param name Name used in the kernel names (`flamey_gathermin_name`, ...).
+    * @param type Type of the values.
+    * @param mask Signed integer type of the same size as `type`, used for the vector comparisons.
+*/
+#define FLAMEY_GATHER_DEFINE(name, type, mask) \
+    typedef type flamey_vgather_##name __attribute__((vector_size(FLAMEY_GATHER_BYTES))); \
+    typedef mask flamey_vgmask_##name __attribute__((vector_size(FLAMEY_GATHER_BYTES))); \
+    \
+    FLAMEY_GATHER_DEFINE_OP(min, <, name, type, (FLAMEY_GATHER_BYTES / sizeof(type))) \
+    FLAMEY_GATHER_DEFINE_OP(max, >, name, type, (FLAMEY_GATHER_BYTES / sizeof(type)))
+
+#define FLAMEY_GATHER_DEFINE_OP(op, order, name, type, lanes) \
+    static inline type flamey_gather##op##_##name(const void* first, size_t stride, size_t start, size_t end) \
+    { \
+        const char* item = (const char*) first + start * stride; \
+        size_t vectors = (end - start + 1) / lanes, rest = (end - start + 1) % lanes; \
+        type best = *(const type*) item; \
+        \
+        if (vectors > 0) \
+        { \
+            flamey_vgather_##name bests = (flamey_vgather_##name) { 0 } + best; \
+            \
+            for (size_t v = 0; v < vectors; v++, item += lanes * stride) \
+            { \
+                flamey_vgather_##name x; \
+                \
+                _Pragma("GCC unroll 8") \
+                for (size_t k = 0; k < lanes; k++) x[k] = *(const type*) (item + k * stride); \
+                \
+                flamey_vgmask_##name better = x order bests; \
+                \
+                bests = (flamey_vgather_##name) (((flamey_vgmask_##name) x & better) | ((flamey_vgmask_##name) bests & ~better)); \
+            } \
+            \
+            for (size_t k = 0; k < lanes; k++) best = bests[k] order best ? bests[k] : best; \
+        } \
+        \
+        for (size_t k = 0; k < rest; k++) \
+        { \
+            type value = *(const type*) (item + k * stride); \
+            \
+            best = value order best ? value : best; \
+        } \
+        \
+        return best; \
     }
 
-    if (array == nullptr)
-    {
-        fprintf(stderr, "%s(): `array` cannot be a null pointer.\n", funcname);
-        exit(EXIT_FAILURE);
+/**
+    * @brief Defines the sum gather kernel for views of one integer type. The values are added as `long long`, like `average()` does.
+    *
+    *        ### The average user should not use this: use `average()` with a view instead.
+    *
+    * @param name Name used in the kernel name (`flamey_gathersum_name`).
+    * @param type Type of the values.
+*/
+#define FLAMEY_GATHER_DEFINE_SUM(name, type) \
+    static inline long long flamey_gathersum_##name(const void* first, size_t stride, size_t start, size_t end) \
+    { \
+        typedef long long flamey_vsum __attribute__((vector_size(FLAMEY_GATHER_BYTES))); \
+        \
+        const char* item = (const char*) first + start * stride; \
+        size_t lanes = sizeof(flamey_vsum) / sizeof(long long), vectors = (end - start + 1) / lanes, rest = (end - start + 1) % lanes; \
+        flamey_vsum sums = { 0 }; \
+        long long sum = 0; \
+        \
+        for (size_t v = 0; v < vectors; v++, item += lanes * stride) \
+        { \
+            flamey_vsum x; \
+            \
+            _Pragma("GCC unroll 4") \
+            for (size_t k = 0; k < lanes; k++) x[k] = *(const type*) (item + k * stride); \
+            \
+            sums += x; \
+        } \
+        \
+        for (size_t k = 0; k < rest; k++) sum += *(const type*) (item + k * stride); \
+        \
+        for (size_t k = 0; k < lanes; k++) sum += sums[k]; \
+        \
+        return sum; \
     }
+
+FLAMEY_GATHER_DEFINE(int, int, int)
+FLAMEY_GATHER_DEFINE(uint, unsigned int, int)
+FLAMEY_GATHER_DEFINE(long, long, long)
+FLAMEY_GATHER_DEFINE(ulong, unsigned long, long)
+FLAMEY_GATHER_DEFINE(llong, long long, long long)
+FLAMEY_GATHER_DEFINE(ullong, unsigned long long, long long)
+FLAMEY_GATHER_DEFINE(float, float, int)
+FLAMEY_GATHER_DEFINE(double, double, long long)
+
+FLAMEY_GATHER_DEFINE_SUM(int, int)
+FLAMEY_GATHER_DEFINE_SUM(uint, unsigned int)
+FLAMEY_GATHER_DEFINE_SUM(long, long)
+FLAMEY_GATHER_DEFINE_SUM(ulong, unsigned long)
+FLAMEY_GATHER_DEFINE_SUM(llong, long long)
+FLAMEY_GATHER_DEFINE_SUM(ullong, unsigned long long)
+
+#define flamey_gatherkernels(op) \
+    int*: &flamey_gather##op##_int, \
+    unsigned int*: &flamey_gather##op##_uint, \
+    long*: &flamey_gather##op##_long, \
+    unsigned long*: &flamey_gather##op##_ulong, \
+    long long*: &flamey_gather##op##_llong, \
+    unsigned long long*: &flamey_gather##op##_ullong
+
+/**
+    * @brief Gets the gather kernel for a view, or `nullptr` if there isn't one for the type of its values (or if `array` isn't a view).
+    *           The cast gives `nullptr` the type of a kernel, so that the call to it compiles either way.
+    *
+    *        ### The average user should not use this: use `min()`, `max()` and `average()` with a view instead.
+    *
+    * @param array The view (or array) given to the macro.
+    * @param op `min`, `max` or `sum`.
+    * @param result The type the kernel returns.
+*/
+#define flamey_gatherkernel(array, op, result) \
+    ((result (*)(const void*, size_t, size_t, size_t)) (flamey_isview(array) ? _Generic((flamey_unqual(flamey_at(array, 0))*) nullptr, \
+        flamey_gatherkernels(op), flamey_gatherfloats_##op default: nullptr) : nullptr))
+
+#define flamey_gatherfloats_min float*: &flamey_gathermin_float, double*: &flamey_gathermin_double,
+#define flamey_gatherfloats_max float*: &flamey_gathermax_float, double*: &flamey_gathermax_double,
+#define flamey_gatherfloats_sum
+
+/*
+    INSTRUMENTATION
+*/
+
+/*
+    Define `FLAMEY_INSTRUMENT` before including this header to count, per thread, what the sorting and array macros do.
+    Define `FLAMEY_INSTRUMENT_TIME` as well to also time each macro call (with `rdtsc` on x86, `clock_gettime()` elsewhere).
+    Without `FLAMEY_INSTRUMENT`, the counting code isn't compiled at all.
+*/
+
+/**
+    * @brief The macros that are counted, used as indices in `flamey_stats`.
+*/
+enum flamey_op
+{
+    FLAMEY_OP_QSORT,
+    FLAMEY_OP_BSORT,
+    FLAMEY_OP_GSORT,
+    FLAMEY_OP_IS_SORTED,
+    FLAMEY_OP_SHUFFLE,
+    FLAMEY_OP_AVERAGE,
+    FLAMEY_OP_MIN,
+    FLAMEY_OP_MAX,
+    FLAMEY_OP_MED,
+    FLAMEY_OP_IMIN,
+    FLAMEY_OP_IMAX,
+    FLAMEY_OP_IMED,
+    FLAMEY_OP_SCAN,
+    FLAMEY_OP_CSORT,
+    FLAMEY_OP_KSORT,
+    FLAMEY_OP_ARGSORT,
+    FLAMEY_OP_SORT,
+    FLAMEY_OP_SEGSORT,
+    FLAMEY_OPS
+};
+
+/**
+    * @brief What a macro did since the counters were last reset.
+*/
+typedef struct flamey_counters
+{
+    unsigned long long calls;
+    unsigned long long checks;
+    unsigned long long comparisons;
+    unsigned long long swaps;
+    unsigned long long bytes_moved;
+    unsigned long long ticks;
+} flamey_counters;
+
+/**
+    * @brief Counters of the current thread, indexed by `enum flamey_op`.
+*/
+extern _Thread_local flamey_counters flamey_stats[FLAMEY_OPS];
+
+/**
+    * @brief Prints the counters of the current thread, for every macro that was called.
+    *
+    * @param stream Where to print the counters (ex.: `stderr`).
+*/
+FLAMEY_DEF void flamey_dumpcounters(FILE* stream);
+
+/**
+    * @brief Sets all counters of the current thread back to `0`.
+*/
+FLAMEY_DEF void flamey_resetcounters(void);
+
+/**
+    * @brief Gets a timestamp for `FLAMEY_INSTRUMENT_TIME`: CPU cycles with `rdtsc` on x86, nanoseconds elsewhere.
+*/
+static inline unsigned long long flamey_ticks(void)
+{
+#if defined(FLAMEY_INSTRUMENT_TIME) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec * 1000000000ull + time.tv_nsec;
+#endif
 }
 
+#ifdef FLAMEY_INSTRUMENT
+#define FLAMEY_COUNT(op, field, amount) ((void) (flamey_stats[op].field += (amount)))
+#define FLAMEY_COMPARE(op, compare, a, b) (FLAMEY_COUNT(op, comparisons, 1), (*compare)(a, b))
+#else
+#define FLAMEY_COUNT(op, field, amount) ((void) 0)
+#define FLAMEY_COMPARE(op, compare, a, b) ((*compare)(a, b))
+#endif
+
+#define FLAMEY_COUNT_SWAP(op, size) (FLAMEY_COUNT(op, swaps, 1), FLAMEY_COUNT(op, bytes_moved, 2 * (size)))
+
+#if defined(FLAMEY_INSTRUMENT) && defined(FLAMEY_INSTRUMENT_TIME)
+#define FLAMEY_BEGIN(op) unsigned long long flamey_begin = (FLAMEY_COUNT(op, calls, 1), FLAMEY_COUNT(op, checks, FLAMEY_RUNTIME_CHECKS), flamey_ticks())
+#define FLAMEY_END(op) FLAMEY_COUNT(op, ticks, flamey_ticks() - flamey_begin)
+#else
+#define FLAMEY_BEGIN(op) (FLAMEY_COUNT(op, calls, 1), FLAMEY_COUNT(op, checks, FLAMEY_RUNTIME_CHECKS))
+#define FLAMEY_END(op) ((void) 0)
+#endif
+
 /*
     STRING UTILITIES
 */
@@ -99,20 +554,12 @@ void validarrcheck
     * @param start The string index to start modifying from (`0` to start from the beginning).
     * @param end The string index to stop modifying at (string length - 1 to finish at the end).
 */
-void lowercase
+FLAMEY_DEF void lowercase
 (
     char* string,
     size_t start,
     size_t end
-)
-{
-    validarrcheck(string, start, end, "lowercase");
-    
-    for (size_t i = start; i <= end; i++)
-    {
-        string[i] = tolower(string[i]);
-    }
-}
+);
 
 /**
     * @brief Converts a string to uppercase.
@@ -121,112 +568,241 @@ void lowercase
     * @param start The string index to start modifying from (`0` to start from the beginning).
     * @param end The string index to stop modifying at (string length - 1 to finish at the end).
 */
-void uppercase
+FLAMEY_DEF void uppercase
 (
     char* string,
     size_t start,
     size_t end
-)
-{
-    validarrcheck(string, start, end, "uppercase");
-    
-    for (size_t i = start; i <= end; i++)
-    {
-        string[i] = toupper(string[i]);
-    }
-}
+);
 
-/*
-    INPUT FUNCTIONS
+/**
+    * @brief A non-owning view into a string, made of a pointer and a length.
+    *           Views are never null-terminated: always use `length` to know where they end.
 */
+typedef struct strview
+{
+    const char* data;
+    size_t length;
+} strview;
 
 /**
-    * @brief Writes a hint towards what the user should insert, then puts the user input inside a variable.
-    *           Values from the `va_list` can be written inside the hint.
+    * @brief Makes a view into a part of a string, without copying it.
     *
-    *        ### The average user should not use this: use `input()` instead.
+    * @param string The string to view.
+    * @param start The string index the view starts at (`0` to start from the beginning).
+    * @param end The string index the view stops at (string length - 1 to finish at the end).
     *
-    * @param text Hint to the user about what should be written.
-    * @param format C format specifier that will be passed to `scanf()`'s first argument.
-    * @param pointer Variable to store the user's value.
-    * @param args `va_list` for `vprintf()` used by `text`.
+    * @return A view of `string` from `start` to `end`.
 */
-void vinput
+static inline strview strview_of
 (
-    const char* text,
-    const char* format,
-    void* pointer,
-    va_list args
+    const char* string,
+    size_t start,
+    size_t end
 )
 {
-    vprintf(text, args);
-    fflush(stdin);
-    scanf(format, pointer);
+    if (!arrcheck(string, start, end, "strview_of")) return (strview) { nullptr, 0 };
+
+    return (strview) { string + start, end + 1 - start };
 }
 
 /**
-    * @brief Writes a hint towards what the user should insert, then puts the user input inside a variable.
+    * @brief Checks if a view has the same contents as a null-terminated string.
     *
-    * @param text Hint to the user about what should be written.
-    * @param format C format specifier that will be passed to `scanf()`'s first argument.
-    * @param pointer Variable to store the user's value.
-    * @param ... Values for `text`'s formats.
+    * @param view The view to compare.
+    * @param string The null-terminated string to compare.
+    *
+    * @return `true` if both have the same characters, `false` otherwise.
 */
-void input
+static inline bool strview_equals
 (
-    const char* text,
-    const char* format,
-    void* pointer,
-    ...
+    strview view,
+    const char* string
 )
 {
-    va_list args;
-    va_start(args, pointer);
-
-    vinput(text, format, pointer, args);
-
-    va_end(args);
+    return strlen(string) == view.length && memcmp(view.data, string, view.length) == 0;
 }
 
 /**
-    * @brief Same as `input()`, but checks the input against a condition and retries if it doesn't match.
-    *           Values from the `va_list` can be written inside the hint.
-    * 
-    *        ### The average user should not use this: use `cinput()` instead.
+    * @brief Finds the first occurrence of a character inside a string.
+    *           This is a wrapper for `string.h`'s `memchr()` function, which is vectorized by the C library.
     *
-    * @param text Hint to the user about what should be written.
-    * @param format C format specifier that will be passed to `scanf()`'s first argument.
-    * @param pointer Variable to store the user's value.
-    * @param fail Text to display if the condition is false.
-    * @param condition Boolean function to test against constants.
-    * @param args `va_list` for `vprintf()` used by `text`.
+    * @param string The string to search.
+    * @param start The string index to start searching from (`0` to start from the beginning).
+    * @param end The string index to stop searching at (string length - 1 to finish at the end).
+    * @param character The character to look for.
+    *
+    * @return The index of the first occurrence of `character`, or `npos` if it wasn't found.
 */
-void cvinput
+FLAMEY_DEF size_t strfindchr
 (
-    const char* text,
-    const char* format,
-    void* pointer,
-    const char* fail,
-    bool (*condition)(void*),
-    va_list args
-)
-{
-    va_list copy;
-
-    do
-    {
-        va_copy(copy, args);
-
-        vinput(text, format, pointer, copy);
-
-        if (!(*condition)(pointer))
-        {
-            printf(fail);
-        }
-    } while (!(*condition)(pointer));
+    const char* string,
+    size_t start,
+    size_t end,
+    char character
+);
 
-    va_end(copy);
-}
+/**
+    * @brief Finds the first occurrence of a substring inside a string.
+    *           Candidate positions are found 16 at a time by matching the first and last characters of `needle` with SSE2,
+    *           and only those candidates are compared fully. Falls back to a scalar loop without SSE2.
+    *
+    * @param string The string to search.
+    * @param start The string index to start searching from (`0` to start from the beginning).
+    * @param end The string index to stop searching at (string length - 1 to finish at the end).
+    * @param needle The null-terminated substring to look for.
+    *
+    * @return The index where the first occurrence of `needle` starts, or `npos` if it wasn't found.
+*/
+FLAMEY_DEF size_t strfind
+(
+    const char* string,
+    size_t start,
+    size_t end,
+    const char* needle
+);
+
+/**
+    * @brief Finds the first character inside a string that is part of a set of characters.
+    *           With SSE2 and up to 16 characters in the set, 16 string characters are checked at a time.
+    *           Otherwise, a 256-entry lookup table is used.
+    *
+    * @param string The string to search.
+    * @param start The string index to start searching from (`0` to start from the beginning).
+    * @param end The string index to stop searching at (string length - 1 to finish at the end).
+    * @param characters The null-terminated set of characters to look for.
+    *
+    * @return The index of the first character found, or `npos` if none were found.
+*/
+FLAMEY_DEF size_t strfindany
+(
+    const char* string,
+    size_t start,
+    size_t end,
+    const char* characters
+);
+
+/**
+    * @brief State of a `strsplit_next()` loop. Create it with `strsplit_init()`.
+*/
+typedef struct strsplit
+{
+    const char* string;
+    size_t position;
+    size_t end;
+    const char* delimiters;
+    bool skipempty;
+    bool done;
+} strsplit;
+
+/**
+    * @brief Prepares an iterator that splits a string into views, without modifying or copying it (unlike `strtok()`).
+    *
+    * @param iterator The iterator to prepare.
+    * @param string The string to split.
+    * @param start The string index to start splitting from (`0` to start from the beginning).
+    * @param end The string index to stop splitting at (string length - 1 to finish at the end).
+    * @param delimiters The null-terminated set of characters that separate tokens.
+    * @param skipempty Whether or not to skip empty tokens between consecutive delimiters, like `strtok()` does.
+*/
+FLAMEY_DEF void strsplit_init
+(
+    strsplit* iterator,
+    const char* string,
+    size_t start,
+    size_t end,
+    const char* delimiters,
+    bool skipempty
+);
+
+/**
+    * @brief Gets the next token of a split string.
+    *
+    *        Example:
+    *```c
+    *strsplit words;
+    *strview word;
+    *
+    *strsplit_init(&words, line, 0, strlen(line) - 1, " \t", true);
+    *
+    *while (strsplit_next(&words, &word))
+    *{
+    *    printf("%.*s\n", (int) word.length, word.data);
+    *}
+    *```
+    *
+    * @param iterator The iterator made by `strsplit_init()`.
+    * @param token View to store the token.
+    *
+    * @return `true` if a token was found, `false` if the string has no more tokens.
+*/
+FLAMEY_DEF bool strsplit_next
+(
+    strsplit* iterator,
+    strview* token
+);
+
+/*
+    INPUT FUNCTIONS
+*/
+
+/**
+    * @brief Writes a hint towards what the user should insert, then puts the user input inside a variable.
+    *           Values from the `va_list` can be written inside the hint.
+    *
+    *        ### The average user should not use this: use `input()` instead.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param pointer Variable to store the user's value.
+    * @param args `va_list` for `vprintf()` used by `text`.
+*/
+FLAMEY_DEF void vinput
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    va_list args
+);
+
+/**
+    * @brief Writes a hint towards what the user should insert, then puts the user input inside a variable.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param pointer Variable to store the user's value.
+    * @param ... Values for `text`'s formats.
+*/
+FLAMEY_DEF void input
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    ...
+);
+
+/**
+    * @brief Same as `input()`, but checks the input against a condition and retries if it doesn't match.
+    *           Values from the `va_list` can be written inside the hint.
+    * 
+    *        ### The average user should not use this: use `cinput()` instead.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param pointer Variable to store the user's value.
+    * @param fail Text to display if the condition is false.
+    * @param condition Boolean function to test against constants.
+    * @param args `va_list` for `vprintf()` used by `text`.
+*/
+FLAMEY_DEF void cvinput
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    const char* fail,
+    bool (*condition)(void*),
+    va_list args
+);
 
 /**
     * @brief Same as `input()`, but checks the input against a condition and retries if it doesn't match.
@@ -246,7 +822,7 @@ void cvinput
     * @param condition Boolean function to test against constants.
     * @param ... Values for `text`'s formats.
 */
-void cinput
+FLAMEY_DEF void cinput
 (
     const char* text,
     const char* format,
@@ -254,15 +830,7 @@ void cinput
     const char* fail,
     bool (*condition)(void*),
     ...
-)
-{
-    va_list args;
-    va_start(args, condition);
-
-    cvinput(text, format, pointer, fail, condition, args);
-
-    va_end(args);
-}
+);
 
 /**
     * @brief Same as `input()`, but checks the input against a condition and retries if it doesn't match.
@@ -279,7 +847,7 @@ void cinput
     * @param condargs `va_list` used by `condition`.
     * @param args `va_list` for `vprintf()` used by `text`.
 */
-void vcvinput
+FLAMEY_DEF void vcvinput
 (
     const char* text,
     const char* format,
@@ -288,28 +856,7 @@ void vcvinput
     bool (*condition)(void*, va_list),
     va_list condargs,
     va_list args
-)
-{
-    va_list argscopy, condargscopy;
-
-    do
-    {
-        va_copy(argscopy, args);
-        va_copy(condargscopy, condargs);
-
-        vinput(text, format, pointer, argscopy);
- 
-        if (!(*condition)(pointer, condargscopy))
-        {
-            printf(fail);
-        }
-
-        va_copy(condargscopy, condargs);
-    } while (!(*condition)(pointer, condargscopy));
-
-    va_end(argscopy);
-    va_end(condargscopy);
-}
+);
 
 /**
     * @brief Same as `input()`, but checks the input against a condition and retries if it doesn't match.
@@ -337,7 +884,7 @@ void vcvinput
     * @param condargs `va_list` used by `condition`.
     * @param ... Values for `text`'s formats.
 */
-void vcinput
+FLAMEY_DEF void vcinput
 (
     const char* text,
     const char* format, 
@@ -346,15 +893,27 @@ void vcinput
     bool (*condition)(void*, va_list),
     va_list condargs,
     ...
-)
-{
-    va_list args;
-    va_start(args, condargs);
-
-    vcvinput(text, format, pointer, fail, condition, condargs, args);
+);
 
-    va_end(args);
-}
+/**
+    * @brief Writes the hint for one array element, with `ordinal` before or after `text`.
+    *
+    *        ### The average user should not use this: it is used by the array input functions.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param ordinal Format string for the current number in the array (ex.: `"Insert the %dth number: "`).
+    * @param index The array index being written.
+    * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
+    * @param args `va_list` for `vprintf()` used by `text`.
+*/
+FLAMEY_DEF void flamey_promptat
+(
+    const char* text,
+    const char* ordinal,
+    size_t index,
+    bool ordinalBefore,
+    va_list args
+);
 
 /**
     * @brief Writes a hint towards what the user should insert, then puts the user input inside an array, in order.
@@ -372,7 +931,7 @@ void vcinput
     * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
     * @param args `va_list` for `vprintf()` used by `text`.
 */
-void varrinput
+FLAMEY_DEF void varrinput
 (
     const char* text,
     const char* ordinal,
@@ -383,33 +942,7 @@ void varrinput
     size_t end,
     bool ordinalBefore,
     va_list args
-)
-{
-    validarrcheck(array, start, end, "varrinput");
-
-    va_list copy;
-
-    for (size_t i = start; i <= end; i++)
-    {
-        va_copy(copy, args);
-
-        if (ordinalBefore)
-        {
-            printf(ordinal, i + 1);
-            vprintf(text, copy);
-        }
-        else
-        {
-            vprintf(text, copy);
-            printf(ordinal, i + 1);
-        }
-
-        fflush(stdin);
-        scanf(format, array + (i * size));
-    }
-
-    va_end(copy);
-}
+);
 
 /**
     * @brief Writes a hint towards what the user should insert, then puts the user input inside an array, in order.
@@ -424,7 +957,7 @@ void varrinput
     * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
     * @param ... Values for `text`'s formats.
 */
-void arrinput
+FLAMEY_DEF void arrinput
 (
     const char* text,
     const char* ordinal,
@@ -435,17 +968,7 @@ void arrinput
     size_t end,
     bool ordinalBefore,
     ...
-)
-{
-    validarrcheck(array, start, end, "arrinput");
-
-    va_list args;
-    va_start(args, ordinalBefore);
-
-    varrinput(text, ordinal, format, array, size, start, end, ordinalBefore, args);
-
-    va_end(args);
-}
+);
 
 /**
     * @brief Same as `arrinput()`, but checks the input against a condition and retries if it doesn't match.
@@ -465,7 +988,7 @@ void arrinput
     * @param condition Boolean function to test against constants.
     * @param args `va_list` for `vprintf()` used by `text`.
 */
-void cvarrinput
+FLAMEY_DEF void cvarrinput
 (
     const char* text,
     const char* ordinal,
@@ -478,41 +1001,7 @@ void cvarrinput
     const char* fail,
     bool (*condition)(void*),
     va_list args
-)
-{
-    validarrcheck(array, start, end, "cvarrinput");
-
-    va_list copy;
-
-    for (size_t i = 0; i <= end; i++)
-    {
-        do
-        {
-            va_copy(copy, args);
-
-            if (ordinalBefore)
-            {
-                printf(ordinal, i + 1);
-                vprintf(text, copy);
-            }
-            else
-            {
-                vprintf(text, copy);
-                printf(ordinal, i + 1);
-            }
-
-            fflush(stdin);
-            scanf(format, array + (i * size));
-
-            if (!(*condition)(array + (i * size)))
-            {
-                printf(fail);
-            }
-        } while (!(*condition)(array + (i * size)));
-    }
-
-    va_end(copy);
-}
+);
 
 /**
     * @brief Same as `arrinput()`, but checks the input against a condition and retries if it doesn't match.
@@ -529,7 +1018,7 @@ void cvarrinput
     * @param condition Boolean function to test against constants.
     * @param ... Values for `text`'s formats.
 */
-void carrinput
+FLAMEY_DEF void carrinput
 (
     const char* text,
     const char* ordinal,
@@ -542,17 +1031,7 @@ void carrinput
     const char* fail,
     bool (*condition)(void*),
     ...
-)
-{
-    validarrcheck(array, start, end, "carrinput");
-
-    va_list args;
-    va_start(args, condition);
-
-    cvarrinput(text, ordinal, format, array, size, start, end, ordinalBefore, fail, condition, args);
-
-    va_end(args);
-}
+);
 
 /**
     * @brief Same as `arrinput()`, but checks the input against a condition and retries if it doesn't match.
@@ -574,7 +1053,7 @@ void carrinput
     * @param condargs `va_list` used by `condition`.
     * @param args `va_list` for `vprintf()` used by `text`.
 */
-void vcvarrinput
+FLAMEY_DEF void vcvarrinput
 (
     const char* text,
     const char* ordinal,
@@ -588,45 +1067,7 @@ void vcvarrinput
     bool (*condition)(void*, va_list),
     va_list condargs,
     va_list args
-)
-{
-    validarrcheck(array, start, end, "vcvarrinput");
-
-    va_list copy, condargscopy;
-
-    for (size_t i = 0; i <= end; i++)
-    {
-        do
-        {
-            va_copy(copy, args);
-            va_copy(condargscopy, condargs);
-
-            if (ordinalBefore)
-            {
-                printf(ordinal, i + 1);
-                vprintf(text, copy);
-            }
-            else
-            {
-                vprintf(text, copy);
-                printf(ordinal, i + 1);
-            }
-
-            fflush(stdin);
-            scanf(format, array + (i * size));
-
-            if (!(*condition)(array + (i * size), condargscopy))
-            {
-                printf(fail);
-            }
-
-            va_copy(condargscopy, condargs);
-        } while (!(*condition)(array + (i * size), condargscopy));
-    }
-
-    va_end(copy);
-    va_end(condargscopy);
-}
+);
 
 /**
     * @brief Same as `carrinput()`, but checks the input against a condition and retries if it doesn't match.
@@ -659,7 +1100,7 @@ void vcvarrinput
     * @param condargs `va_list` used by `condition`.
     * @param ... Values for `text`'s formats.
 */
-void vcarrinput
+FLAMEY_DEF void vcarrinput
 (
     const char* text,
     const char* ordinal,
@@ -673,49 +1114,232 @@ void vcarrinput
     bool (*condition)(void*, va_list),
     va_list condargs,
     ...
-)
-{
-    validarrcheck(array, start, end, "vcarrinput");
-
-    va_list args;
-    va_start(args, condargs);
-
-    vcvarrinput(text, ordinal, format, array, size, start, end, ordinalBefore, fail, condition, condargs, args);
-
-    va_end(args);
-}
-
-/*
-    PRINTING FUNCTIONS
-*/
+);
 
 /**
-    * @brief Prints an array to the standard input in [0, 1, 2, 3, ...] format.
-    * 
-    * @param array The array to print.
-    * @param format C format specifier for the array elements.
-    * @param start The array index to start printing from (`0` to start from the beginning).
-    * @param end The array index to stop printing at (array length - 1 to finish at the end).
-*/
-#define printarr(array, format, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "printarr"); \
-    \
-    printf("["); \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        if (i == end) \
+    * @brief Same as `arrinput()`, but only writes the given array indices, in order.
+    *           Values from the `va_list` can be written inside the hint.
+    *
+    *        ### The average user should not use this: use `arrinputat()` instead.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param ordinal Text to format with the current array index.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param array Array to store the user's values.
+    * @param size Size of each array element.
+    * @param indices The array indices to write.
+    * @param count Number of indices in `indices`.
+    * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
+    * @param args `va_list` for `vprintf()` used by `text`.
+*/
+FLAMEY_DEF void varrinputat
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    const size_t indices[],
+    size_t count,
+    bool ordinalBefore,
+    va_list args
+);
+
+/**
+    * @brief Same as `arrinput()`, but only writes the given array indices, in order.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param ordinal Text to format with the current array index.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param array Array to store the user's values.
+    * @param size Size of each array element.
+    * @param indices The array indices to write.
+    * @param count Number of indices in `indices`.
+    * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
+    * @param ... Values for `text`'s formats.
+*/
+FLAMEY_DEF void arrinputat
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    const size_t indices[],
+    size_t count,
+    bool ordinalBefore,
+    ...
+);
+
+/**
+    * @brief Same as `carrinput()`, but reads all values first, then checks them all at once, then asks again only for the rejected ones.
+    *           Values from the `va_list` can be written inside the hint.
+    *
+    *        ### The average user should not use this: use `bcarrinput()` instead.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param ordinal Text to format with the current array index.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param array Array to store the user's values.
+    * @param size Size of each array element.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
+    * @param fail Text to display before asking again for the rejected values.
+    * @param condition Function that checks the values from `start` to `end` of the array, and sets `valid[i - start]` for each.
+    * @param args `va_list` for `vprintf()` used by `text`.
+*/
+FLAMEY_DEF void bcvarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    void (*condition)(const void*, size_t, size_t, bool*),
+    va_list args
+);
+
+/**
+    * @brief Same as `carrinput()`, but reads all values first, then checks them all at once, then asks again only for the rejected ones.
+    *           With piped input, the whole array is then checked in a single pass.
+    *
+    *        Example `condition` function:
+    *```c
+    *void are_positive(const void* array, size_t start, size_t end, bool* valid)
+    *{
+    *    const int* numbers = array;
+    *
+    *    for (size_t i = start; i <= end; i++)
+    *    {
+    *        valid[i - start] = numbers[i] > 0;
+    *    }
+    *}
+    *```
+    *
+    * @param text Hint to the user about what should be written.
+    * @param ordinal Text to format with the current array index.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param array Array to store the user's values.
+    * @param size Size of each array element.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
+    * @param fail Text to display before asking again for the rejected values.
+    * @param condition Function that checks the values from `start` to `end` of the array, and sets `valid[i - start]` for each.
+    * @param ... Values for `text`'s formats.
+*/
+FLAMEY_DEF void bcarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    void (*condition)(const void*, size_t, size_t, bool*),
+    ...
+);
+
+/**
+    * @brief Same as `bcarrinput()`, but the condition is that every value must be between `minimum` and `maximum`.
+    *           The check is a branchless loop over the array's own type, which the compiler can vectorize.
+    *
+    * @param text Hint to the user about what should be written.
+    * @param ordinal Text to format with the current array index.
+    * @param format C format specifier that will be passed to `scanf()`'s first argument.
+    * @param array Array to store the user's values.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param ordinalBefore Whether or not to display `ordinal` before or after `text`.
+    * @param fail Text to display before asking again for the rejected values.
+    * @param minimum The lowest valid value.
+    * @param maximum The highest valid value.
+    * @param ... Values for `text`'s formats.
+*/
+#define rangearrinput(text, ordinal, format, array, start, end, ordinalBefore, fail, minimum, maximum, ...) ( \
+{ \
+    if (arrcheck(array, start, end, "rangearrinput")) \
+    { \
+        size_t flamey_start = start; \
+        size_t flamey_end = end; \
+        typeof((array)[0]) flamey_low = minimum, flamey_high = maximum; \
+        size_t* flamey_rejected = malloc((flamey_end - flamey_start + 1) * sizeof(size_t)); \
+        size_t flamey_rejections = 0; \
+        \
+        if (flamey_rejected == nullptr) \
         { \
-            printf(format, array[i]); \
+            fprintf(stderr, "rangearrinput(): not enough memory to check %zu values.\n", flamey_end - flamey_start + 1); \
+            exit(EXIT_FAILURE); \
         } \
-        else \
+        \
+        arrinput(text, ordinal, format, array, sizeof((array)[0]), flamey_start, flamey_end, ordinalBefore, ##__VA_ARGS__); \
+        \
+        for (size_t flamey_i = flamey_start; flamey_i <= flamey_end; flamey_i++) \
+        { \
+            flamey_rejected[flamey_rejections] = flamey_i; \
+            flamey_rejections += ((array)[flamey_i] < flamey_low) | ((array)[flamey_i] > flamey_high); \
+        } \
+        \
+        while (flamey_rejections > 0) \
         { \
-            printf(format ", ", array[i]); \
+            size_t flamey_remaining = 0; \
+            \
+            printf("%s", fail); \
+            arrinputat(text, ordinal, format, array, sizeof((array)[0]), flamey_rejected, flamey_rejections, ordinalBefore, ##__VA_ARGS__); \
+            \
+            for (size_t flamey_i = 0; flamey_i < flamey_rejections; flamey_i++) \
+            { \
+                flamey_rejected[flamey_remaining] = flamey_rejected[flamey_i]; \
+                flamey_remaining += ((array)[flamey_rejected[flamey_i]] < flamey_low) | ((array)[flamey_rejected[flamey_i]] > flamey_high); \
+            } \
+            \
+            flamey_rejections = flamey_remaining; \
         } \
+        \
+        free(flamey_rejected); \
+    } \
+})
+
+/*
+    PRINTING FUNCTIONS
+*/
+
+/**
+    * @brief Prints an array to the standard input in [0, 1, 2, 3, ...] format.
+    * 
+    * @param array The array to print.
+    * @param format C format specifier for the array elements.
+    * @param start The array index to start printing from (`0` to start from the beginning).
+    * @param end The array index to stop printing at (array length - 1 to finish at the end).
+*/
+#define printarr(array, format, start, end) ( \
+{ \
+    if (arrcheck(array, start, end, "printarr")) \
+    { \
+        printf("["); \
+        \
+        for (size_t i = start; i <= end; i++) \
+        { \
+            if (i == end) \
+            { \
+                printf(format, flamey_at(array, i)); \
+            } \
+            else \
+            { \
+                printf(format ", ", flamey_at(array, i)); \
+            } \
+        } \
+        \
+        printf("]\n"); \
     } \
-    \
-    printf("]\n"); \
 })
 
 /*
@@ -730,7 +1354,7 @@ void vcarrinput
     *
     * @return A random integer between `min` and `max`.
 */
-int randint
+static inline int randint
 (
     int min,
     int max
@@ -748,410 +1372,6771 @@ int randint
     * @param min The lowest possible number.
     * @param max The highest possible number.
 */
-void randints
+FLAMEY_DEF void randints
 (
     int array[],
     size_t start,
     size_t end,
     int min,
     int max
-)
-{
-    validarrcheck(array, start, end, "randints");
-
-    srand(time(0));
-
-    for (size_t i = start; i <= end; i++)
-    {
-        array[i] = randint(min, max);
-    }
-}
+);
 
 /*
-    ARRAY UTILITIES
+    The bulk generators below don't use `rand()`: they take a `randstate`, which makes them repeatable and lets each thread have its own.
+    `randnormals()`, `randexponentials()` and `randzipfs()` use `log()` and `exp()`, so programs using them must be linked with `-lm`.
 */
 
 /**
-    * @brief Copies the values of an array to another array.
-    * 
-    * @param dest The destination array.
-    * @param orig The original array.
-    * @param start The array index to start copying from (`0` to start from the beginning).
-    * @param end The array index to stop copying at (array length - 1 to finish at the end).
+    * @brief State of the random number generator used by the bulk generators.
+    *           It's four xoshiro256** generators side by side, which are advanced together with vector instructions.
+    *           Set it with `randseed()` before using it.
 */
-#define arrcopy(dest, orig, start, end) ( \
-{ \
-    validarrcheck(orig, start, end, "arrcopy"); \
-    \
-    if (sizeof(dest) / sizeof(dest[0]) < (end - start + 1)) \
-    { \
-        fprintf(stderr, "arrcopy(): `dest` should be big enough to hold `orig`'s items from `start` to end`.\nExpected length of `dest` to be >= %u, but it was %u.\n", end - start + 1, sizeof(dest) / sizeof(dest[0])); \
-        exit(EXIT_FAILURE); \
-    } \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        dest[i] = orig[i]; \
-    } \
-})
+typedef struct randstate
+{
+    uint64_t s[4][4];
+} randstate;
 
 /**
-    * @brief Shuffles an array.
-    * 
-    * @param array The array to shuffle.
-    * @param start The array index to start shuffling from (`0` to start from the beginning).
-    * @param end The array index to stop shuffling at (array length - 1 to finish at the end).
+    * @brief Sets the state of a random number generator from a seed. The same seed always gives the same numbers.
+    *
+    * @param state The state to set.
+    * @param seed Any number (`time(0)`, for example).
 */
-#define shuffle(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "shuffle"); \
-    \
-    srand(time(0)); \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        size_t new_index = randint(start, end); \
-        \
-        swap(&array[i], &array[new_index], sizeof(array[0])); \
-    } \
-})
+FLAMEY_DEF void randseed
+(
+    randstate* state,
+    uint64_t seed
+);
 
 /**
-    * @brief Calculates the average of an array's values.
-    * 
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @brief Inserts random `float`s inside an array, uniformly distributed. Each one has 23 random bits, made into a `float` directly instead of divided.
     *
-    * @return The average of all array values. 
+    * @param array The `float` array to fill.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param min The lowest possible number.
+    * @param max The highest possible number (it's never reached, except by rounding).
+    * @param state The random number generator to use.
 */
-#define average(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "average"); \
-    \
-    long long sum = 0; \
-    long double avg; \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        sum += array[i]; \
-    } \
-    \
-    avg = (long double) sum / (end + 1 - start); \
-    \
-    avg; \
-})
+FLAMEY_DEF void randfloats
+(
+    float array[],
+    size_t start,
+    size_t end,
+    float min,
+    float max,
+    randstate* state
+);
 
 /**
-    * @brief Finds the minimum value in an array.
-    * 
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @brief Inserts random `double`s inside an array, uniformly distributed. Each one has 52 random bits, made into a `double` directly instead of divided.
     *
-    * @return The minimum of all array values. 
+    * @param array The `double` array to fill.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param min The lowest possible number.
+    * @param max The highest possible number (it's never reached, except by rounding).
+    * @param state The random number generator to use.
 */
-#define min(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "min"); \
-    \
-    typeof(array[0]) minimum = array[start]; \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        if (array[i] < minimum) minimum = array[i]; \
-    } \
-    \
-    minimum; \
-})
+FLAMEY_DEF void randdoubles
+(
+    double array[],
+    size_t start,
+    size_t end,
+    double min,
+    double max,
+    randstate* state
+);
 
 /**
-    * @brief Finds the maximum value in an array.
-    * 
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @brief Inserts normally distributed random numbers inside an array, using the Ziggurat algorithm.
     *
-    * @return The maximum of all array values. 
+    * @param array The `double` array to fill.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param mean The mean of the distribution.
+    * @param stddev The standard deviation of the distribution.
+    * @param state The random number generator to use.
 */
-#define max(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "max"); \
-    \
-    typeof(array[0]) maximum = array[start]; \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        if (array[i] > maximum) maximum = array[i]; \
-    } \
-    \
-    maximum; \
-})
+FLAMEY_MATHDEF void randnormals
+(
+    double array[],
+    size_t start,
+    size_t end,
+    double mean,
+    double stddev,
+    randstate* state
+);
 
 /**
-    * @brief Finds the median value in an array.
-    * 
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @brief Inserts exponentially distributed random numbers inside an array, using the Ziggurat algorithm.
     *
-    * @return The median of all array values. 
+    * @param array The `double` array to fill.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param rate The rate of the distribution (the mean is `1 / rate`). Must be positive.
+    * @param state The random number generator to use.
 */
-#define med(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "med"); \
-    \
-    typeof(array[0]) medium = array[start]; \
-    long double avg = average(array, start, end); \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        if (abs(array[i] - avg) < abs(medium - avg)) medium = array[i]; \
-    } \
-    \
-    medium; \
-})
+FLAMEY_MATHDEF void randexponentials
+(
+    double array[],
+    size_t start,
+    size_t end,
+    double rate,
+    randstate* state
+);
 
 /**
-    * @brief Finds the index of the minimum value in an array.
+    * @brief Inserts Zipf-distributed random numbers inside an array: `k` comes out with a probability proportional to `1 / k^exponent`.
+    *           Uses rejection-inversion sampling, so it takes the same time for any `n`, and doesn't need any tables.
     *
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @param array The `size_t` array to fill.
+    * @param start The array index to start writing from (`0` to start from the beginning).
+    * @param end The array index to stop writing at (array length - 1 to finish at the end).
+    * @param n The highest possible number (the lowest is `1`).
+    * @param exponent How much more likely small numbers are. Must be positive.
+    * @param state The random number generator to use.
+*/
+FLAMEY_MATHDEF void randzipfs
+(
+    size_t array[],
+    size_t start,
+    size_t end,
+    size_t n,
+    double exponent,
+    randstate* state
+);
+
+/*
+    PARALLEL UTILITIES
+*/
+
+/*
+    The parallel functions run on a pool of threads that is started the first time it is needed, so programs that never use it don't pay for it.
+    The pool has one thread per CPU (the calling thread counts as one), or as many as the `FLAMEY_THREADS` environment variable says.
+    Calling a parallel function from inside a parallel function runs it on the current thread.
+*/
+
+#define FLAMEY_MAX_THREADS 256
+
+/**
+    * @brief Default number of elements per chunk for `arrmap()`, `arrfill()` and `arriota()`. Can be defined before including this header.
+*/
+#ifndef FLAMEY_GRAIN
+#define FLAMEY_GRAIN 16384
+#endif
+
+/**
+    * @brief Gets the number of threads used by the parallel functions, including the calling thread.
     *
-    * @return The index of the minimum value in `array`. 
+    * @return The number of threads.
 */
-#define imin(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "imin"); \
-    \
-    size_t index = start; \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        if (array[i] < array[index]) index = i; \
-    } \
-    \
-    index; \
-})
+FLAMEY_DEF size_t parallel_threads(void);
 
 /**
-    * @brief Finds the index of the maximum value in an array.
+    * @brief Runs a function over a range of indices, in parallel.
+    *           The range is cut into chunks of `grain` indices. Each thread starts with its own share of chunks,
+    *           and threads that run out of work steal chunks from the others.
     *
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *        Example:
+    *```c
+    *void lowercase_all(size_t start, size_t end, void* strings)
+    *{
+    *    for (size_t i = start; i <= end; i++)
+    *    {
+    *        char* string = ((char**) strings)[i];
+    *        lowercase(string, 0, strlen(string) - 1);
+    *    }
+    *}
     *
-    * @return The index of the maximum value in `array`. 
+    *parallel_for(0, count - 1, 64, lowercase_all, strings);
+    *```
+    *
+    * @param start The first index (`0` to start from the beginning).
+    * @param end The last index (array length - 1 to finish at the end).
+    * @param grain Number of indices per chunk (`0` to let the function choose).
+    * @param function Function called for each chunk, with the first index, the last index and `context`.
+    * @param context Pointer given to `function`.
 */
-#define imax(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "imax"); \
-    \
-    size_t index = start; \
-    \
-    for (size_t i = start; i <= end; i++) \
-    { \
-        if (array[i] > array[index]) index = i; \
-    } \
-    \
-    index; \
-})
+FLAMEY_DEF void parallel_for
+(
+    size_t start,
+    size_t end,
+    size_t grain,
+    void (*function)(size_t, size_t, void*),
+    void* context
+);
 
 /**
-    * @brief Finds the index of the median value in an array.
+    * @brief Same as `parallel_for()`, but the range is cut into one equal chunk per thread, and there is no stealing.
+    *           The same thread always gets the same part of the same range, which keeps memory close to the thread that uses it (NUMA).
     *
-    * @param array The array to scan.
-    * @param start The array index to start scanning from (`0` to start from the beginning).
-    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @param start The first index (`0` to start from the beginning).
+    * @param end The last index (array length - 1 to finish at the end).
+    * @param function Function called for each chunk, with the first index, the last index and `context`.
+    * @param context Pointer given to `function`.
+*/
+FLAMEY_DEF void parallel_for_static
+(
+    size_t start,
+    size_t end,
+    void (*function)(size_t, size_t, void*),
+    void* context
+);
+
+/**
+    * @brief What the file-scope chunk functions of `arrmap()`, `arrfill()` and `arriota()` work on, in unoptimized builds (see `flamey_nestedfor()`).
     *
-    * @return The index of the median value in `array`. 
+    *        ### The average user should not use this.
 */
-#define imed(array, start, end) ( \
-{ \
-    validarrcheck(array, start, end, "imed"); \
-    \
-    size_t index = start; \
-    long double avg = average(array, start, end); \
+typedef struct flamey_arraywork
+{
+    void* to;
+    const void* from;
+    const void* value;
+    void (*function)(void);
+    size_t offset;
+    size_t size;
+} flamey_arraywork;
+
+/**
+    * @brief Defines the file-scope chunk functions of `arrmap()`, `arrfill()` and `arriota()` for one type of array element.
+    *           They do the same as the nested chunk functions of these macros, but they don't need a trampoline, even without optimizations.
+    *
+    *        ### The average user should not use this.
+    *
+    * @param name Name used in the function names (`flamey_fillwork_name`, ...).
+    * @param type Type of the array elements.
+*/
+#define FLAMEY_ARRAYWORK_DEFINE(name, type) \
+    static inline void flamey_mapwork_##name(size_t first, size_t last, void* data) \
+    { \
+        flamey_arraywork* work = data; \
+        type* to = work->to; \
+        const type* from = work->from; \
+        type (*map)(type) = (type (*)(type)) work->function; \
+        \
+        for (size_t i = first; i <= last; i++) to[i] = map(from[i]); \
+    } \
     \
-    for (size_t i = start; i <= end; i++) \
+    static inline void flamey_fillwork_##name(size_t first, size_t last, void* data) \
     { \
-        if (abs(array[i] - avg) < abs(array[index] - avg)) index = i; \
+        flamey_arraywork* work = data; \
+        type* to = work->to; \
+        type fill = *(const type*) work->value; \
+        \
+        for (size_t i = first; i <= last; i++) to[i] = fill; \
     } \
     \
-    index; \
-})
+    static inline void flamey_iotawork_##name(size_t first, size_t last, void* data) \
+    { \
+        flamey_arraywork* work = data; \
+        type* to = work->to; \
+        type base = *(const type*) work->value; \
+        \
+        for (size_t i = first; i <= last; i++) to[i] = base + (type) (i - work->offset); \
+    }
 
-/*
-    ARRAY SORTING FUNCTIONS
+FLAMEY_ARRAYWORK_DEFINE(bool, bool)
+FLAMEY_ARRAYWORK_DEFINE(char, char)
+FLAMEY_ARRAYWORK_DEFINE(schar, signed char)
+FLAMEY_ARRAYWORK_DEFINE(uchar, unsigned char)
+FLAMEY_ARRAYWORK_DEFINE(short, short)
+FLAMEY_ARRAYWORK_DEFINE(ushort, unsigned short)
+FLAMEY_ARRAYWORK_DEFINE(int, int)
+FLAMEY_ARRAYWORK_DEFINE(uint, unsigned int)
+FLAMEY_ARRAYWORK_DEFINE(long, long)
+FLAMEY_ARRAYWORK_DEFINE(ulong, unsigned long)
+FLAMEY_ARRAYWORK_DEFINE(llong, long long)
+FLAMEY_ARRAYWORK_DEFINE(ullong, unsigned long long)
+FLAMEY_ARRAYWORK_DEFINE(float, float)
+FLAMEY_ARRAYWORK_DEFINE(double, double)
+FLAMEY_ARRAYWORK_DEFINE(ldouble, long double)
+
+#define flamey_arrayworks(op) \
+    bool*: &flamey_##op##work_bool, \
+    char*: &flamey_##op##work_char, \
+    signed char*: &flamey_##op##work_schar, \
+    unsigned char*: &flamey_##op##work_uchar, \
+    short*: &flamey_##op##work_short, \
+    unsigned short*: &flamey_##op##work_ushort, \
+    int*: &flamey_##op##work_int, \
+    unsigned int*: &flamey_##op##work_uint, \
+    long*: &flamey_##op##work_long, \
+    unsigned long*: &flamey_##op##work_ulong, \
+    long long*: &flamey_##op##work_llong, \
+    unsigned long long*: &flamey_##op##work_ullong, \
+    float*: &flamey_##op##work_float, \
+    double*: &flamey_##op##work_double, \
+    long double*: &flamey_##op##work_ldouble
+
+/**
+    * @brief `arrfill()`'s file-scope chunk function for the other element types (structures, pointers, ...): copies the value with `memcpy()`.
+    *
+    *        ### The average user should not use this.
 */
+static inline void flamey_fillwork_bytes(size_t first, size_t last, void* data)
+{
+    flamey_arraywork* work = data;
+
+    for (size_t i = first; i <= last; i++) memcpy((char*) work->to + i * work->size, work->value, work->size);
+}
 
 /**
-    * @brief Checks if an array is sorted.
-    * 
-    * @param array The array to check.
-    * @param start The array index to start checking from (`0` to start from the beginning).
-    * @param end The array index to stop checking at (array length - 1 to finish at the end).
-    * @param compare A comparison function. This header provides `ascending()` and `descending()`, but you can make your own.
+    * @brief Runs the chunks of a parallel array macro with `parallel_for()`. With optimizations, they are run by the macro's nested chunk function:
+    *           it only uses its `data`, so GCC doesn't give it a trampoline, and the macro's function or comparator can be inlined into it.
+    *           Without optimizations, GCC gives every nested function whose address is taken a trampoline on the stack (which makes the whole program's
+    *           stack executable), so `worker`, a file-scope chunk function, is run on `work` instead. If there's no `worker` for these types
+    *           (`nullptr`, only for `arrmap()` with a function that doesn't take and return the element type of both arrays), the chunks are run by
+    *           a direct call on the calling thread.
     *
-    * @return `true` if `array` is sorted, `false` otherwise.
+    *        ### The average user should not use this: it's used by `arrmap()`, `arrfill()`, `arriota()` and `segsort()`.
 */
-#define is_sorted(array, start, end, compare) ( \
+#ifdef __OPTIMIZE__
+#define flamey_nestedfor(start, end, grain, function, context, worker, work) parallel_for(start, end, grain, function, context)
+#else
+#define flamey_nestedfor(start, end, grain, function, context, worker, work) \
+    __builtin_choose_expr(__builtin_types_compatible_p(typeof(worker), typeof(nullptr)), function(start, end, context), parallel_for(start, end, grain, worker, work))
+#endif
+
+/**
+    * @brief Gets `function` if it's known at compile time (a function name), so that the chunks call it directly and it can be inlined,
+    *           or `stored`, the copy of it in the context of the chunks, if it's a variable that a nested function would have to reach through a trampoline.
+    *
+    *        ### The average user should not use this: it's used by `arrmap()` and `segsort()`.
+*/
+#define flamey_direct(function, stored) __builtin_choose_expr(__builtin_constant_p(function), function, stored)
+
+/**
+    * @brief Gets `arrmap()`'s file-scope chunk function for `dest`, `orig` and `function` (see `flamey_nestedfor()`),
+    *           or `nullptr` if `function` doesn't take and return the element type of both arrays.
+    *
+    *        ### The average user should not use this: it's used by `arrmap()`.
+*/
+#define flamey_mapworker(dest, orig, function) \
+    __builtin_choose_expr(__builtin_types_compatible_p(typeof(&*(function)), typeof((dest)[0]) (*)(typeof((dest)[0]))) && \
+        __builtin_types_compatible_p(typeof((dest)[0]), typeof((orig)[0])), _Generic(&(dest)[0], flamey_arrayworks(map), default: nullptr), nullptr)
+
+/**
+    * @brief Applies a function to every element of an array, in parallel, and puts the results in another array (`dest[i] = function(orig[i])`).
+    *           `dest` and `orig` can be the same array.
+    *
+    * @param dest The destination array.
+    * @param orig The original array.
+    * @param start The array index to start from (`0` to start from the beginning).
+    * @param end The array index to stop at (array length - 1 to finish at the end).
+    * @param function A function (or a pointer to one) that takes an element of `orig` and returns an element of `dest`.
+    *                 A pointer is kept in the context of the chunks, so that they don't need a trampoline (and an executable stack).
+*/
+#define arrmap(dest, orig, start, end, function) ( \
 { \
-    validarrcheck(array, start, end, "is_sorted"); \
-    \
-    bool result = true; \
-    \
-    for (size_t i = start + 1; i <= end; i++) \
+    if (arrcheck(orig, start, end, "arrmap")) \
     { \
-        if ((*compare)(&array[i - 1], &array[i]) > 0) \
+        struct flamey_mapcontext { typeof(&(dest)[0]) to; typeof(&(orig)[0]) from; typeof(&*(function)) map; } flamey_context = \
+            { &(dest)[0], &(orig)[0], &*(function) }; \
+        \
+        void flamey_mapchunk(size_t flamey_first, size_t flamey_last, void* flamey_data) \
         { \
-            result = false; \
+            struct flamey_mapcontext* flamey_chunk = flamey_data; \
+            \
+            for (size_t flamey_i = flamey_first; flamey_i <= flamey_last; flamey_i++) \
+            { \
+                flamey_chunk->to[flamey_i] = flamey_direct(function, flamey_chunk->map)(flamey_chunk->from[flamey_i]); \
+            } \
         } \
+        \
+        flamey_nestedfor(start, end, FLAMEY_GRAIN, flamey_mapchunk, &flamey_context, flamey_mapworker(dest, orig, function), \
+            (&(flamey_arraywork) { flamey_context.to, flamey_context.from, nullptr, (void (*)(void)) flamey_context.map, 0, 0 })); \
     } \
-    \
-    result; \
 })
 
 /**
-    * @brief Sorts an array using the Quick Sort algorithm.
-    *           Partitions the array around a pivot element, then recursively sorts the left and right subarrays.
-    *           This macro is a wrapper for `stdlib.h`'s `qsort()` function.
-    * 
-    * @param array The array to sort.
-    * @param start The array index to start sorting from (`0` to start from the beginning).
-    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
-    * @param compare A comparison function. This header provides `ascending()` and `descending()`, but you can make your own.
+    * @brief Sets every element of an array to the same value, in parallel.
+    *
+    * @param array The array to fill.
+    * @param start The array index to start filling from (`0` to start from the beginning).
+    * @param end The array index to stop filling at (array length - 1 to finish at the end).
+    * @param value The value to put in the array.
 */
-#define qsort(array, start, end, compare) ( \
+#define arrfill(array, start, end, value) ( \
 { \
-    validarrcheck(array, start, end, "qsort"); \
-    \
-    qsort(array + start, end + 1 - start, sizeof(array[0]), compare); \
+    if (arrcheck(array, start, end, "arrfill")) \
+    { \
+        struct flamey_fillcontext { typeof(&(array)[0]) to; typeof((array)[0]) fill; } flamey_context = { &(array)[0], value }; \
+        \
+        void flamey_fillchunk(size_t flamey_first, size_t flamey_last, void* flamey_data) \
+        { \
+            struct flamey_fillcontext* flamey_chunk = flamey_data; \
+            \
+            for (size_t flamey_i = flamey_first; flamey_i <= flamey_last; flamey_i++) \
+            { \
+                flamey_chunk->to[flamey_i] = flamey_chunk->fill; \
+            } \
+        } \
+        \
+        flamey_nestedfor(start, end, FLAMEY_GRAIN, flamey_fillchunk, &flamey_context, \
+            _Generic(&(array)[0], flamey_arrayworks(fill), default: &flamey_fillwork_bytes), \
+            (&(flamey_arraywork) { flamey_context.to, nullptr, &flamey_context.fill, nullptr, 0, sizeof(flamey_context.fill) })); \
+    } \
 })
 
 /**
-    * @brief Sorts an array using the Bubble Sort algorithm.
-    *           Checks two items at a time: if they aren't in order, swaps them. Iterates over the array until it is all sorted.
-    * 
-    * @param array The array to sort.
-    * @param start The array index to start sorting from (`0` to start from the beginning).
-    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
-    * @param compare A comparison function. This header provides `ascending()` and `descending()`, but you can make your own.
+    * @brief Fills an array with increasing values (`first`, `first + 1`, `first + 2`, ...), in parallel.
+    *
+    * @param array The array to fill.
+    * @param start The array index to start filling from (`0` to start from the beginning).
+    * @param end The array index to stop filling at (array length - 1 to finish at the end).
+    * @param first The value to put at `start`.
 */
-#define bsort(array, start, end, compare) ( \
+#define arriota(array, start, end, first) ( \
 { \
-    validarrcheck(array, start, end, "bsort"); \
-    \
-    for (size_t i = start; i < end; i++) \
+    if (arrcheck(array, start, end, "arriota")) \
     { \
-        for (size_t j = start; j < end - i; j++) \
+        struct flamey_iotacontext { typeof(&(array)[0]) to; typeof((array)[0]) base; size_t offset; } flamey_context = \
+            { &(array)[0], first, start }; \
+        \
+        void flamey_iotachunk(size_t flamey_low, size_t flamey_high, void* flamey_data) \
         { \
-            if ((*compare)(&array[j], &array[j + 1]) > 0) \
+            struct flamey_iotacontext* flamey_chunk = flamey_data; \
+            \
+            for (size_t flamey_i = flamey_low; flamey_i <= flamey_high; flamey_i++) \
             { \
-                swap(&array[j], &array[j + 1], sizeof(array[0])); \
+                flamey_chunk->to[flamey_i] = flamey_chunk->base + (typeof(flamey_chunk->base)) (flamey_i - flamey_chunk->offset); \
             } \
         } \
+        \
+        flamey_nestedfor(start, end, FLAMEY_GRAIN, flamey_iotachunk, &flamey_context, _Generic(&(array)[0], flamey_arrayworks(iota), default: nullptr), \
+            (&(flamey_arraywork) { flamey_context.to, nullptr, &flamey_context.base, nullptr, flamey_context.offset, 0 })); \
     } \
 })
 
+/*
+    ARRAY UTILITIES
+*/
+
 /**
-    * @brief Sorts an array using the Gnome Sort algorithm.
-    *           Reads through the array. When it finds an unsorted item, it runs through the previously read items to find the place to put it.
+    * @brief Size in bytes from which `streamcopy()` bypasses the caches. Can be defined before including this header (`0` to use the size of the last-level cache).
+*/
+#ifndef FLAMEY_STREAM_COPY
+#define FLAMEY_STREAM_COPY 0
+#endif
+
+/**
+    * @brief Size in bytes from which `streamcopy()` uses all the threads of the pool. Can be defined before including this header.
+*/
+#ifndef FLAMEY_PARALLEL_COPY
+#define FLAMEY_PARALLEL_COPY 67108864
+#endif
+
+/**
+    * @brief Copies memory, like `memmove()`: the two areas can overlap.
+    *           Copies bigger than the last-level cache use non-temporal stores, so they don't push everything else out of the cache,
+    *           and copies bigger than `FLAMEY_PARALLEL_COPY` are split between all the threads of the pool.
+    *
+    * @param dest The destination.
+    * @param orig The memory to copy.
+    * @param size Number of bytes to copy.
+    *
+    * @return `dest`.
+*/
+FLAMEY_DEF void* streamcopy
+(
+    void* dest,
+    const void* orig,
+    size_t size
+);
+
+/**
+    * @brief Gets the length of an array, or `npos` if it's a pointer (whose length isn't known).
+    *           The `+ 0` stops GCC from warning about the division in the branch that pointers never take.
+*/
+#define flamey_arrlen(array) \
+    __builtin_choose_expr(__builtin_types_compatible_p(typeof(array), typeof(&(array)[0])), npos, (sizeof(array) + 0) / sizeof((array)[0]))
+
+/**
+    * @brief Copies the values of an array to the beginning of another array (`dest[0] = orig[start]`, `dest[1] = orig[start + 1]`, ...).
+    *           The two arrays can overlap. If they have the same element type, the copy is done with `streamcopy()`.
     * 
-    * @param array The array to sort.
-    * @param start The array index to start sorting from (`0` to start from the beginning).
-    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
-    * @param compare A comparison function. This header provides `ascending()` and `descending()`, but you can make your own.
+    * @param dest The destination array. If it's an array (and not a pointer), its length is checked.
+    * @param orig The original array.
+    * @param start The array index to start copying from (`0` to start from the beginning).
+    * @param end The array index to stop copying at (array length - 1 to finish at the end).
 */
-#define gsort(array, start, end, compare) ( \
+#define arrcopy(dest, orig, start, end) ( \
 { \
-    validarrcheck(array, start, end, "gsort"); \
-    \
-    for (size_t i = start + 1; i <= end; i++) \
+    if (arrcheck(orig, start, end, "arrcopy")) \
     { \
-        if ((*compare)(&array[i - 1], &array[i]) > 0) \
+        if (flamey_arrlen(dest) < (end - start + 1)) \
+        { \
+            fprintf(stderr, "arrcopy(): `dest` should be big enough to hold `orig`'s items from `start` to `end`.\nExpected length of `dest` to be >= %zu, but it was %zu.\n", (size_t) (end - start + 1), flamey_arrlen(dest)); \
+            exit(EXIT_FAILURE); \
+        } \
+        \
+        if (__builtin_types_compatible_p(typeof((dest)[0]), typeof(orig[0]))) \
+        { \
+            streamcopy(&(dest)[0], &(orig)[start], (end - start + 1) * sizeof(orig[0])); \
+        } \
+        else \
         { \
-            for (size_t j = start; j < i; j++) \
+            for (size_t i = start; i <= end; i++) \
             { \
-                if (!((*compare)(&array[i], &array[j]) > 0)) \
-                { \
-                    swap(&array[i], &array[j], sizeof(array[0])); \
-                } \
+                (dest)[i - start] = orig[i]; \
             } \
         } \
     } \
 })
 
 /**
-    * @brief "Sorts" an array using the Bogosort *joke* algorithm.
-    *           Shuffles the list. If it isn't sorted, shuffle again.
+    * @brief Same as `shuffle()`, but without checking the array indices. Used by macros that already checked them.
+    *
+    *        ### The average user should not use this: use `shuffle()` instead.
     * 
-    * @param array The array to sort.
-    * @param start The array index to start sorting from (`0` to start from the beginning).
-    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
-    * @param compare A comparison function. This header provides `ascending()` and `descending()`, but you can make your own.
+    * @param array The array to shuffle.
+    * @param start The array index to start shuffling from (`0` to start from the beginning).
+    * @param end The array index to stop shuffling at (array length - 1 to finish at the end).
 */
-#define bogosort(array, start, end, compare) ( \
+#define shuffle_unchecked(array, start, end) ( \
 { \
-    validarrcheck(array, start, end, "bogosort"); \
+    srand(time(0)); \
     \
-    while (!is_sorted(array, start, end, compare)) \
+    for (size_t i = start; i <= end; i++) \
     { \
-        shuffle(array, start, end); \
+        size_t new_index = randint(start, end); \
+        \
+        swap(&array[i], &array[new_index], sizeof(array[0])); \
+        FLAMEY_COUNT_SWAP(FLAMEY_OP_SHUFFLE, sizeof(array[0])); \
     } \
 })
 
 /**
-    * @brief "Sorts" an array using the Miracle Sort *joke* algorithm. Do not use this.
-    *           Constantly checks if the list has been sorted by a cosmic ray causing a bit flip.
+    * @brief Shuffles an array.
     * 
-    * @param array The array to sort.
-    * @param start The array index to start sorting from (`0` to start from the beginning).
-    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
-    * @param compare A comparison function. This header provides `ascending()` and `descending()`, but you can make your own.
+    * @param array The array to shuffle.
+    * @param start The array index to start shuffling from (`0` to start from the beginning).
+    * @param end The array index to stop shuffling at (array length - 1 to finish at the end).
 */
-#define mrclsort(array, start, end, compare) ( \
+#define shuffle(array, start, end) ( \
 { \
-    validarrcheck(array, start, end, "mrclsort"); \
+    FLAMEY_BEGIN(FLAMEY_OP_SHUFFLE); \
     \
-    while (!(is_sorted(array, start, end, compare))) {} \
+    if (arrcheck(array, start, end, "shuffle")) shuffle_unchecked(array, start, end); \
+    \
+    FLAMEY_END(FLAMEY_OP_SHUFFLE); \
 })
 
-/*
-    SORT DIRECTION UTILITIES
-*/
-
 /**
-    * @brief Comparison function for sorting an array in ascending order.
+    * @brief Same as `average()`, but without checking the array indices. Used by macros that already checked them.
+    *
+    *        ### The average user should not use this: use `average()` instead.
     * 
-    * @param a The first element to compare.
-    * @param b The second element to compare.
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The average of all array values. 
+*/
+#define average_unchecked(array, start, end) ( \
+{ \
+    long long sum = 0; \
+    long long (*flamey_kernel)(const void*, size_t, size_t, size_t) = flamey_gatherkernel(array, sum, long long); \
+    \
+    if (flamey_kernel != nullptr) \
+    { \
+        sum = flamey_kernel(flamey_asview(array).first, flamey_asview(array).stride, start, end); \
+    } \
+    else \
+    { \
+        for (size_t i = start; i <= end; i++) \
+        { \
+            sum += flamey_at(array, i); \
+        } \
+    } \
+    \
+    FLAMEY_COUNT(FLAMEY_OP_AVERAGE, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    \
+    (long double) sum / (end + 1 - start); \
+})
+
+/**
+    * @brief Calculates the average of an array's values.
+    * 
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The average of all array values. 
+*/
+#define average(array, start, end) ( \
+{ \
+    long double avg = 0; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_AVERAGE); \
+    \
+    if (arrcheck(array, start, end, "average")) avg = average_unchecked(array, start, end); \
+    \
+    FLAMEY_END(FLAMEY_OP_AVERAGE); \
+    \
+    avg; \
+})
+
+/**
+    * @brief Finds the minimum value in an array.
+    * 
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The minimum of all array values. 
+*/
+#define min(array, start, end) ( \
+{ \
+    flamey_unqual(flamey_at(array, 0)) minimum = { 0 }; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_MIN); \
+    \
+    if (arrcheck(array, start, end, "min")) \
+    { \
+        flamey_unqual(flamey_at(array, 0)) (*flamey_kernel)(const void*, size_t, size_t, size_t) = flamey_gatherkernel(array, min, flamey_unqual(flamey_at(array, 0))); \
+        \
+        minimum = flamey_at(array, start); \
+        \
+        if (flamey_kernel != nullptr) \
+        { \
+            minimum = flamey_kernel(flamey_asview(array).first, flamey_asview(array).stride, start, end); \
+        } \
+        else \
+        { \
+            for (size_t i = start; i <= end; i++) \
+            { \
+                if (flamey_at(array, i) < minimum) minimum = flamey_at(array, i); \
+            } \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_MIN, comparisons, end + 1 - start); \
+        FLAMEY_COUNT(FLAMEY_OP_MIN, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_MIN); \
+    \
+    minimum; \
+})
+
+/**
+    * @brief Finds the maximum value in an array.
+    * 
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The maximum of all array values. 
+*/
+#define max(array, start, end) ( \
+{ \
+    flamey_unqual(flamey_at(array, 0)) maximum = { 0 }; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_MAX); \
+    \
+    if (arrcheck(array, start, end, "max")) \
+    { \
+        flamey_unqual(flamey_at(array, 0)) (*flamey_kernel)(const void*, size_t, size_t, size_t) = flamey_gatherkernel(array, max, flamey_unqual(flamey_at(array, 0))); \
+        \
+        maximum = flamey_at(array, start); \
+        \
+        if (flamey_kernel != nullptr) \
+        { \
+            maximum = flamey_kernel(flamey_asview(array).first, flamey_asview(array).stride, start, end); \
+        } \
+        else \
+        { \
+            for (size_t i = start; i <= end; i++) \
+            { \
+                if (flamey_at(array, i) > maximum) maximum = flamey_at(array, i); \
+            } \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_MAX, comparisons, end + 1 - start); \
+        FLAMEY_COUNT(FLAMEY_OP_MAX, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_MAX); \
+    \
+    maximum; \
+})
+
+/**
+    * @brief Finds the median value in an array.
     * 
-    * @return The difference between the two elements.
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The median of all array values. 
+*/
+#define med(array, start, end) ( \
+{ \
+    flamey_unqual(flamey_at(array, 0)) medium = { 0 }; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_MED); \
+    \
+    if (arrcheck(array, start, end, "med")) \
+    { \
+        long double avg = average_unchecked(array, start, end); \
+        \
+        medium = flamey_at(array, start); \
+        \
+        for (size_t i = start; i <= end; i++) \
+        { \
+            if (abs(flamey_at(array, i) - avg) < abs(medium - avg)) medium = flamey_at(array, i); \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_MED, comparisons, end + 1 - start); \
+        FLAMEY_COUNT(FLAMEY_OP_MED, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_MED); \
+    \
+    medium; \
+})
+
+/**
+    * @brief Finds the index of the minimum value in an array.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The index of the minimum value in `array`. 
+*/
+#define imin(array, start, end) ( \
+{ \
+    size_t index = start; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_IMIN); \
+    \
+    if (arrcheck(array, start, end, "imin")) \
+    { \
+        for (size_t i = start; i <= end; i++) \
+        { \
+            if (flamey_at(array, i) < flamey_at(array, index)) index = i; \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_IMIN, comparisons, end + 1 - start); \
+        FLAMEY_COUNT(FLAMEY_OP_IMIN, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_IMIN); \
+    \
+    index; \
+})
+
+/**
+    * @brief Finds the index of the maximum value in an array.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The index of the maximum value in `array`. 
+*/
+#define imax(array, start, end) ( \
+{ \
+    size_t index = start; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_IMAX); \
+    \
+    if (arrcheck(array, start, end, "imax")) \
+    { \
+        for (size_t i = start; i <= end; i++) \
+        { \
+            if (flamey_at(array, i) > flamey_at(array, index)) index = i; \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_IMAX, comparisons, end + 1 - start); \
+        FLAMEY_COUNT(FLAMEY_OP_IMAX, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_IMAX); \
+    \
+    index; \
+})
+
+/**
+    * @brief Finds the index of the median value in an array.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    *
+    * @return The index of the median value in `array`. 
+*/
+#define imed(array, start, end) ( \
+{ \
+    size_t index = start; \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_IMED); \
+    \
+    if (arrcheck(array, start, end, "imed")) \
+    { \
+        long double avg = average_unchecked(array, start, end); \
+        \
+        for (size_t i = start; i <= end; i++) \
+        { \
+            if (abs(flamey_at(array, i) - avg) < abs(flamey_at(array, index) - avg)) index = i; \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_IMED, comparisons, end + 1 - start); \
+        FLAMEY_COUNT(FLAMEY_OP_IMED, bytes_moved, (end + 1 - start) * sizeof(flamey_at(array, 0))); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_IMED); \
+    \
+    index; \
+})
+
+/*
+    SCAN FUNCTIONS
+*/
+
+/*
+    A scan replaces every element of a range with the sum (or the minimum, or the maximum) of the elements up to it.
+    The inclusive scans (`scansum()`, `scanmin()`, `scanmax()`) count the element itself, the exclusive ones (`exscansum()`, `exscanmin()`, `exscanmax()`) don't.
+    Arrays of `int`, `long`, `long long`, `float`, `double` and their unsigned versions are scanned a whole vector register at a time,
+    and ranges longer than `FLAMEY_SCAN_PARALLEL` elements are scanned by all the threads of the pool, in two passes. Other types are scanned one element at a time.
+*/
+
+/**
+    * @brief Number of elements from which the scans use all the threads of the pool. Can be defined before including this header.
+*/
+#ifndef FLAMEY_SCAN_PARALLEL
+#define FLAMEY_SCAN_PARALLEL 1048576
+#endif
+
+#define flamey_scanop_sum(a, b) ((a) + (b))
+#define flamey_scanop_min(a, b) ((b) < (a) ? (b) : (a))
+#define flamey_scanop_max(a, b) ((b) > (a) ? (b) : (a))
+
+#define flamey_scanseed_sum(first) 0
+#define flamey_scanseed_min(first) (first)
+#define flamey_scanseed_max(first) (first)
+
+#define flamey_vscanop_sum(a, b, mask) ((a) + (b))
+#define flamey_vscanop_min(a, b, mask) ((typeof(a)) (((mask) (b) & (mask) ((b) < (a))) | ((mask) (a) & ~(mask) ((b) < (a)))))
+#define flamey_vscanop_max(a, b, mask) ((typeof(a)) (((mask) (b) & (mask) ((b) > (a))) | ((mask) (a) & ~(mask) ((b) > (a)))))
+
+#define flamey_vscanfill_sum(x) ((typeof(x)) { 0 })
+#define flamey_vscanfill_min(x) ((typeof(x)) { 0 } + (x)[0])
+#define flamey_vscanfill_max(x) ((typeof(x)) { 0 } + (x)[0])
+
+#define flamey_vshift4(x, fill, mask) __builtin_shuffle(x, fill, (mask) { 4, 0, 1, 2 })
+#define flamey_vshift2(x, fill, mask) __builtin_shuffle(x, fill, (mask) { 2, 0 })
+
+#define flamey_vscan4(op, x, mask) ( \
+    x = flamey_vscanop_##op(x, __builtin_shuffle(x, flamey_vscanfill_##op(x), (mask) { 4, 0, 1, 2 }), mask), \
+    x = flamey_vscanop_##op(x, __builtin_shuffle(x, flamey_vscanfill_##op(x), (mask) { 4, 5, 0, 1 }), mask))
+
+#define flamey_vscan2(op, x, mask) ( \
+    x = flamey_vscanop_##op(x, __builtin_shuffle(x, flamey_vscanfill_##op(x), (mask) { 2, 0 }), mask))
+
+/**
+    * @brief Defines the scan kernels for one type of array element: an in-register scan of one block, and a two-pass multithreaded scan built on it.
+    *
+    *        ### The average user should not use this: use `scansum()`, `scanmin()`, `scanmax()` and their `ex` versions instead.
+    *
+    * @param name Name used in the kernel names (`flamey_scan_sum_name`, ...).
+    * @param type Type of the array elements.
+    * @param mask Signed integer type of the same size as `type`, used for the vector comparisons.
+    * @param lanes Number of `type` elements in 16 bytes (`2` or `4`).
 */
-int ascending
+#define FLAMEY_SCAN_DEFINE(name, type, mask, lanes) \
+    typedef type flamey_vec_##name __attribute__((vector_size(16))); \
+    typedef mask flamey_vmask_##name __attribute__((vector_size(16))); \
+    \
+    typedef struct flamey_scancontext_##name \
+    { \
+        type* array; \
+        size_t start; \
+        size_t grain; \
+        bool exclusive; \
+        type carry[FLAMEY_MAX_THREADS]; \
+    } flamey_scancontext_##name; \
+    \
+    FLAMEY_SCAN_DEFINE_OP(sum, name, type, lanes) \
+    FLAMEY_SCAN_DEFINE_OP(min, name, type, lanes) \
+    FLAMEY_SCAN_DEFINE_OP(max, name, type, lanes)
+
+#define FLAMEY_SCAN_DEFINE_OP(op, name, type, lanes) \
+    static inline type flamey_scanblock_##op##_##name(type* array, size_t first, size_t last, type carry, bool exclusive) \
+    { \
+        size_t i = first; \
+        \
+        for (; i <= last && last - i >= lanes - 1; i += lanes) \
+        { \
+            flamey_vec_##name x; \
+            \
+            memcpy(&x, &array[i], sizeof(x)); \
+            flamey_vscan##lanes(op, x, flamey_vmask_##name); \
+            x = flamey_vscanop_##op(x, (flamey_vec_##name) { 0 } + carry, flamey_vmask_##name); \
+            \
+            type next = x[lanes - 1]; \
+            \
+            if (exclusive) x = flamey_vshift##lanes(x, (flamey_vec_##name) { 0 } + carry, flamey_vmask_##name); \
+            \
+            memcpy(&array[i], &x, sizeof(x)); \
+            carry = next; \
+        } \
+        \
+        for (; i <= last; i++) \
+        { \
+            type next = flamey_scanop_##op(carry, array[i]); \
+            \
+            array[i] = exclusive ? carry : next; \
+            carry = next; \
+        } \
+        \
+        return carry; \
+    } \
+    \
+    static inline void flamey_scantotal_##op##_##name(size_t first, size_t last, void* data) \
+    { \
+        flamey_scancontext_##name* context = data; \
+        type total = context->array[first]; \
+        \
+        for (size_t i = first + 1; i <= last; i++) \
+        { \
+            total = flamey_scanop_##op(total, context->array[i]); \
+        } \
+        \
+        context->carry[(first - context->start) / context->grain] = total; \
+    } \
+    \
+    static inline void flamey_scanpass_##op##_##name(size_t first, size_t last, void* data) \
+    { \
+        flamey_scancontext_##name* context = data; \
+        \
+        flamey_scanblock_##op##_##name(context->array, first, last, context->carry[(first - context->start) / context->grain], context->exclusive); \
+    } \
+    \
+    static inline void flamey_scan_##op##_##name(type* array, size_t start, size_t end, bool exclusive) \
+    { \
+        type seed = flamey_scanseed_##op(array[start]); \
+        \
+        if (end - start < FLAMEY_SCAN_PARALLEL || parallel_threads() == 1) \
+        { \
+            flamey_scanblock_##op##_##name(array, start, end, seed, exclusive); \
+            return; \
+        } \
+        \
+        flamey_scancontext_##name context = { array, start, (end - start) / parallel_threads() + 1, exclusive, { 0 } }; \
+        \
+        parallel_for_static(start, end, flamey_scantotal_##op##_##name, &context); \
+        \
+        for (size_t k = 0; k <= (end - start) / context.grain; k++) \
+        { \
+            type total = context.carry[k]; \
+            \
+            context.carry[k] = seed; \
+            seed = flamey_scanop_##op(seed, total); \
+        } \
+        \
+        parallel_for_static(start, end, flamey_scanpass_##op##_##name, &context); \
+    }
+
+FLAMEY_SCAN_DEFINE(int, int, int, 4)
+FLAMEY_SCAN_DEFINE(uint, unsigned int, int, 4)
+#if __LONG_MAX__ == __LONG_LONG_MAX__
+FLAMEY_SCAN_DEFINE(long, long, long, 2)
+FLAMEY_SCAN_DEFINE(ulong, unsigned long, long, 2)
+#else
+FLAMEY_SCAN_DEFINE(long, long, long, 4)
+FLAMEY_SCAN_DEFINE(ulong, unsigned long, long, 4)
+#endif
+FLAMEY_SCAN_DEFINE(llong, long long, long long, 2)
+FLAMEY_SCAN_DEFINE(ullong, unsigned long long, long long, 2)
+FLAMEY_SCAN_DEFINE(float, float, int, 4)
+FLAMEY_SCAN_DEFINE(double, double, long long, 2)
+
+#define flamey_scankernels(op) \
+    int*: &flamey_scan_##op##_int, \
+    unsigned int*: &flamey_scan_##op##_uint, \
+    long*: &flamey_scan_##op##_long, \
+    unsigned long*: &flamey_scan_##op##_ulong, \
+    long long*: &flamey_scan_##op##_llong, \
+    unsigned long long*: &flamey_scan_##op##_ullong, \
+    float*: &flamey_scan_##op##_float, \
+    double*: &flamey_scan_##op##_double
+
+/**
+    * @brief Scans an array in place with one of the scan operators. Used by the scan macros.
+    *
+    *        ### The average user should not use this: use `scansum()`, `scanmin()`, `scanmax()` and their `ex` versions instead.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+    * @param op The operator: `sum`, `min` or `max`.
+    * @param exclusive Whether the scan is exclusive.
+    * @param funcname The name of the calling macro, for the error messages.
+*/
+#define flamey_scan(array, start, end, op, exclusive, funcname) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_SCAN); \
+    \
+    if (arrcheck(array, start, end, funcname)) \
+    { \
+        void (*flamey_kernel)(typeof(&(array)[0]), size_t, size_t, bool) = _Generic(&(array)[0], flamey_scankernels(op), default: nullptr); \
+        \
+        if (flamey_kernel != nullptr) \
+        { \
+            flamey_kernel(&(array)[0], start, end, exclusive); \
+        } \
+        else \
+        { \
+            typeof(array[0]) flamey_carry = flamey_scanseed_##op(array[start]); \
+            \
+            for (size_t i = start; i <= end; i++) \
+            { \
+                typeof(array[0]) flamey_next = flamey_scanop_##op(flamey_carry, array[i]); \
+                \
+                array[i] = (exclusive) ? flamey_carry : flamey_next; \
+                flamey_carry = flamey_next; \
+            } \
+        } \
+        \
+        FLAMEY_COUNT(FLAMEY_OP_SCAN, bytes_moved, 2 * (end + 1 - start) * sizeof(array[0])); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_SCAN); \
+})
+
+/**
+    * @brief Replaces every element of an array with the sum of the elements from `start` up to it (inclusive prefix sum).
+    *
+    *        Example: `[3, 1, 4, 1, 5]` becomes `[3, 4, 8, 9, 14]`.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+*/
+#define scansum(array, start, end) flamey_scan(array, start, end, sum, false, "scansum")
+
+/**
+    * @brief Replaces every element of an array with the minimum of the elements from `start` up to it (running minimum).
+    *
+    *        Example: `[3, 1, 4, 1, 5]` becomes `[3, 1, 1, 1, 1]`.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+*/
+#define scanmin(array, start, end) flamey_scan(array, start, end, min, false, "scanmin")
+
+/**
+    * @brief Replaces every element of an array with the maximum of the elements from `start` up to it (running maximum).
+    *
+    *        Example: `[3, 1, 4, 1, 5]` becomes `[3, 3, 4, 4, 5]`.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+*/
+#define scanmax(array, start, end) flamey_scan(array, start, end, max, false, "scanmax")
+
+/**
+    * @brief Replaces every element of an array with the sum of the elements from `start` up to the one before it (exclusive prefix sum).
+    *           The element at `start` becomes `0`. Useful to turn counts into offsets.
+    *
+    *        Example: `[3, 1, 4, 1, 5]` becomes `[0, 3, 4, 8, 9]`.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+*/
+#define exscansum(array, start, end) flamey_scan(array, start, end, sum, true, "exscansum")
+
+/**
+    * @brief Replaces every element of an array with the minimum of the elements from `start` up to the one before it.
+    *           The element at `start` doesn't change.
+    *
+    *        Example: `[3, 1, 4, 1, 5]` becomes `[3, 3, 1, 1, 1]`.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+*/
+#define exscanmin(array, start, end) flamey_scan(array, start, end, min, true, "exscanmin")
+
+/**
+    * @brief Replaces every element of an array with the maximum of the elements from `start` up to the one before it.
+    *           The element at `start` doesn't change.
+    *
+    *        Example: `[3, 1, 4, 1, 5]` becomes `[3, 3, 3, 4, 4]`.
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param end The array index to stop scanning at (array length - 1 to finish at the end).
+*/
+#define exscanmax(array, start, end) flamey_scan(array, start, end, max, true, "exscanmax")
+
+/*
+    ARRAY SORTING FUNCTIONS
+*/
+
+/**
+    * @brief Same as `is_sorted()`, but without checking the array indices. Used by macros that already checked them.
+    *
+    *        ### The average user should not use this: use `is_sorted()` instead.
+    * 
+    * @param array The array to check.
+    * @param start The array index to start checking from (`0` to start from the beginning).
+    * @param end The array index to stop checking at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+    *
+    * @return `true` if `array` is sorted, `false` otherwise.
+*/
+#define is_sorted_unchecked(array, start, end, compare) ( \
+{ \
+    bool result = true; \
+    \
+    for (size_t i = start + 1; i <= end; i++) \
+    { \
+        if (FLAMEY_COMPARE(FLAMEY_OP_IS_SORTED, compare, &flamey_at(array, i - 1), &flamey_at(array, i)) > 0) \
+        { \
+            result = false; \
+        } \
+    } \
+    \
+    result; \
+})
+
+/**
+    * @brief Checks if an array is sorted.
+    * 
+    * @param array The array to check.
+    * @param start The array index to start checking from (`0` to start from the beginning).
+    * @param end The array index to stop checking at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+    *
+    * @return `true` if `array` is sorted, `false` otherwise.
+*/
+#define is_sorted(array, start, end, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_IS_SORTED); \
+    \
+    bool sorted = arrcheck(array, start, end, "is_sorted") && is_sorted_unchecked(array, start, end, compare); \
+    \
+    FLAMEY_END(FLAMEY_OP_IS_SORTED); \
+    \
+    sorted; \
+})
+
+/**
+    * @brief Sorts part of an array with Insertion Sort, without checking the array indices. Used by `sort()` and `flamey_introsort()`.
+    *
+    *        ### The average user should not use this: use `sort()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+    * @param compare A comparison function.
+    * @param op The `enum flamey_op` to count comparisons and moved bytes under.
+*/
+#define flamey_insertionsort(array, start, end, compare, op) ( \
+{ \
+    typedef typeof((array)[0]) flamey_sorted; \
+    \
+    ptrdiff_t flamey_first = (ptrdiff_t) (start), flamey_last = (ptrdiff_t) (end); \
+    \
+    for (ptrdiff_t flamey_i = flamey_first + 1; flamey_i <= flamey_last; flamey_i++) \
+    { \
+        flamey_sorted flamey_held = (array)[flamey_i]; \
+        ptrdiff_t flamey_j = flamey_i; \
+        \
+        while (flamey_j > flamey_first && FLAMEY_COMPARE(op, compare, &flamey_held, &(array)[flamey_j - 1]) < 0) \
+        { \
+            (array)[flamey_j] = (array)[flamey_j - 1]; \
+            flamey_j--; \
+        } \
+        \
+        (array)[flamey_j] = flamey_held; \
+        FLAMEY_COUNT(op, bytes_moved, (flamey_i - flamey_j + 1) * sizeof(flamey_sorted)); \
+    } \
+})
+
+/**
+    * @brief Sorts part of an array with introsort, without checking the array indices. Used by the sorting macros.
+    *           Quick Sort with a median-of-three pivot, Heap Sort if the partitions get too unbalanced, and Insertion Sort for small partitions.
+    *           Elements are moved as values of their own type and `compare` is called directly, so it can be inlined.
+    *
+    *        ### The average user should not use this: use `qsort()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+    * @param compare A comparison function.
+    * @param op The `enum flamey_op` to count comparisons and swaps under.
+*/
+#define flamey_introsort(array, start, end, compare, op) ( \
+{ \
+    typedef typeof(array[0]) flamey_item; \
+    \
+    ptrdiff_t flamey_lows[64], flamey_highs[64]; \
+    int flamey_limits[64]; \
+    int flamey_top = 1; \
+    \
+    flamey_lows[0] = (ptrdiff_t) (start); \
+    flamey_highs[0] = (ptrdiff_t) (end); \
+    flamey_limits[0] = 2 * (64 - __builtin_clzll((unsigned long long) (end) - (start) + 1)); \
+    \
+    while (flamey_top > 0) \
+    { \
+        flamey_top--; \
+        \
+        ptrdiff_t flamey_low = flamey_lows[flamey_top]; \
+        ptrdiff_t flamey_high = flamey_highs[flamey_top]; \
+        int flamey_limit = flamey_limits[flamey_top]; \
+        \
+        while (flamey_high - flamey_low > 16) \
+        { \
+            if (flamey_limit-- == 0) \
+            { \
+                ptrdiff_t flamey_count = flamey_high - flamey_low + 1; \
+                \
+                for (ptrdiff_t flamey_step = flamey_count + flamey_count / 2 - 1; flamey_step > 0; flamey_step--) \
+                { \
+                    ptrdiff_t flamey_root = flamey_step - flamey_count, flamey_size = flamey_count; \
+                    \
+                    if (flamey_step < flamey_count) \
+                    { \
+                        flamey_item flamey_held = (array)[flamey_low]; \
+                        (array)[flamey_low] = (array)[flamey_low + flamey_step]; \
+                        (array)[flamey_low + flamey_step] = flamey_held; \
+                        FLAMEY_COUNT_SWAP(op, sizeof(flamey_item)); \
+                        flamey_root = 0; \
+                        flamey_size = flamey_step; \
+                    } \
+                    \
+                    for (ptrdiff_t flamey_child = 2 * flamey_root + 1; flamey_child < flamey_size; flamey_child = 2 * flamey_root + 1) \
+                    { \
+                        if (flamey_child + 1 < flamey_size && FLAMEY_COMPARE(op, compare, &(array)[flamey_low + flamey_child], &(array)[flamey_low + flamey_child + 1]) < 0) flamey_child++; \
+                        if (FLAMEY_COMPARE(op, compare, &(array)[flamey_low + flamey_root], &(array)[flamey_low + flamey_child]) >= 0) break; \
+                        \
+                        flamey_item flamey_parent = (array)[flamey_low + flamey_root]; \
+                        (array)[flamey_low + flamey_root] = (array)[flamey_low + flamey_child]; \
+                        (array)[flamey_low + flamey_child] = flamey_parent; \
+                        FLAMEY_COUNT_SWAP(op, sizeof(flamey_item)); \
+                        flamey_root = flamey_child; \
+                    } \
+                } \
+                \
+                flamey_low = flamey_high; \
+                break; \
+            } \
+            \
+            ptrdiff_t flamey_middle = flamey_low + (flamey_high - flamey_low) / 2; \
+            flamey_item flamey_pivot; \
+            \
+            if (FLAMEY_COMPARE(op, compare, &(array)[flamey_middle], &(array)[flamey_low]) < 0) { flamey_pivot = (array)[flamey_middle]; (array)[flamey_middle] = (array)[flamey_low]; (array)[flamey_low] = flamey_pivot; } \
+            if (FLAMEY_COMPARE(op, compare, &(array)[flamey_high], &(array)[flamey_middle]) < 0) { flamey_pivot = (array)[flamey_middle]; (array)[flamey_middle] = (array)[flamey_high]; (array)[flamey_high] = flamey_pivot; } \
+            if (FLAMEY_COMPARE(op, compare, &(array)[flamey_middle], &(array)[flamey_low]) < 0) { flamey_pivot = (array)[flamey_middle]; (array)[flamey_middle] = (array)[flamey_low]; (array)[flamey_low] = flamey_pivot; } \
+            \
+            flamey_pivot = (array)[flamey_middle]; \
+            \
+            ptrdiff_t flamey_i = flamey_low, flamey_j = flamey_high; \
+            \
+            while (flamey_i <= flamey_j) \
+            { \
+                while (FLAMEY_COMPARE(op, compare, &(array)[flamey_i], &flamey_pivot) < 0) flamey_i++; \
+                while (FLAMEY_COMPARE(op, compare, &flamey_pivot, &(array)[flamey_j]) < 0) flamey_j--; \
+                \
+                if (flamey_i <= flamey_j) \
+                { \
+                    flamey_item flamey_other = (array)[flamey_i]; \
+                    (array)[flamey_i] = (array)[flamey_j]; \
+                    (array)[flamey_j] = flamey_other; \
+                    FLAMEY_COUNT_SWAP(op, sizeof(flamey_item)); \
+                    flamey_i++; \
+                    flamey_j--; \
+                } \
+            } \
+            \
+            if (flamey_j - flamey_low < flamey_high - flamey_i) \
+            { \
+                flamey_lows[flamey_top] = flamey_i; \
+                flamey_highs[flamey_top] = flamey_high; \
+                flamey_limits[flamey_top++] = flamey_limit; \
+                flamey_high = flamey_j; \
+            } \
+            else \
+            { \
+                flamey_lows[flamey_top] = flamey_low; \
+                flamey_highs[flamey_top] = flamey_j; \
+                flamey_limits[flamey_top++] = flamey_limit; \
+                flamey_low = flamey_i; \
+            } \
+        } \
+        \
+        flamey_insertionsort(array, flamey_low, flamey_high, compare, op); \
+    } \
+})
+
+/*
+    Adaptive sort: `sort()` looks at the array before choosing how to sort it.
+    The thresholds below can be defined before including this header, for example after timing `sort()` with `bench`.
+*/
+
+/**
+    * @brief Arrays of up to this many elements are sorted with a sorting network (at most `8`).
+*/
+#ifndef FLAMEY_SORT_NETWORK
+#define FLAMEY_SORT_NETWORK 8
+#endif
+
+/**
+    * @brief Arrays of up to this many elements are sorted with Insertion Sort.
+*/
+#ifndef FLAMEY_SORT_INSERTION
+#define FLAMEY_SORT_INSERTION 24
+#endif
+
+/**
+    * @brief Number of pairs of neighbouring elements compared to guess if an array is already (almost) sorted.
+*/
+#ifndef FLAMEY_SORT_SAMPLE
+#define FLAMEY_SORT_SAMPLE 32
+#endif
+
+/**
+    * @brief An almost sorted array is sorted by merging its runs if they are this long on average. Otherwise, it's sorted like a random one.
+*/
+#ifndef FLAMEY_SORT_RUNLENGTH
+#define FLAMEY_SORT_RUNLENGTH 64
+#endif
+
+/**
+    * @brief Arrays of integers with at least this many elements, sorted with an integer `ascending()` function, are sorted with Counting Sort or Radix Sort.
+*/
+#ifndef FLAMEY_SORT_RADIX
+#define FLAMEY_SORT_RADIX 512
+#endif
+
+/**
+    * @brief If it isn't `nullptr`, `sort()` calls this function every time it chooses an algorithm, to help with tuning the thresholds.
+    *
+    *        Example:
+    *```c
+    *void print_choice(const char* algorithm, size_t count, size_t size)
+    *{
+    *    fprintf(stderr, "sort(): %zu elements of %zu bytes, %s\n", count, size, algorithm);
+    *}
+    *
+    *sorthook = print_choice;
+    *```
+    *
+    * @param algorithm `"network"`, `"insertion"`, `"sorted"`, `"reversed"`, `"runs"`, `"counting"`, `"radix"`, `"introsort"` or `"view"`.
+    * @param count The number of elements being sorted.
+    * @param size The size of an element, in bytes.
+*/
+extern void (*sorthook)(const char* algorithm, size_t count, size_t size);
+
+#define flamey_sortchoice(algorithm, count, size) (sorthook != nullptr ? sorthook(algorithm, count, size) : (void) 0)
+
+/**
+    * @brief Gets `value` if it's an integer, or `0` otherwise. Used to compile the integer-only parts of `sort()` for any type.
+*/
+#define flamey_radixkey(value) __builtin_choose_expr(flamey_isintegerexpr(value), (value), 0)
+
+/**
+    * @brief Sorts an array of integers in ascending order with LSD Radix Sort, one byte at a time, skipping the bytes that are the same in every element.
+    *
+    *        ### The average user should not use this: use `sort()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+    *
+    * @return `true` if the array was sorted, `false` if there wasn't enough memory for the buffer (and nothing was done).
+*/
+#define flamey_radixsort(array, start, end) ( \
+{ \
+    typedef typeof(array[0]) flamey_item; \
+    \
+    size_t flamey_count = (end) - (start) + 1; \
+    flamey_item* flamey_buffer = malloc(flamey_count * sizeof(flamey_item)); \
+    \
+    if (flamey_buffer != nullptr) \
+    { \
+        size_t flamey_digits[sizeof(flamey_item)][256] = { { 0 } }; \
+        unsigned long long flamey_flip = (flamey_item) -1 < (flamey_item) 0 ? 1ull << (8 * sizeof(flamey_item) - 1) : 0; \
+        flamey_item* flamey_from = &(array)[start]; \
+        flamey_item* flamey_to = flamey_buffer; \
+        \
+        for (size_t flamey_i = 0; flamey_i < flamey_count; flamey_i++) \
+        { \
+            unsigned long long flamey_key = (unsigned long long) flamey_from[flamey_i] ^ flamey_flip; \
+            \
+            for (size_t flamey_d = 0; flamey_d < sizeof(flamey_item); flamey_d++) flamey_digits[flamey_d][(flamey_key >> (8 * flamey_d)) & 255]++; \
+        } \
+        \
+        for (size_t flamey_d = 0; flamey_d < sizeof(flamey_item); flamey_d++) \
+        { \
+            unsigned long long flamey_first = (unsigned long long) flamey_from[0] ^ flamey_flip; \
+            \
+            if (flamey_digits[flamey_d][(flamey_first >> (8 * flamey_d)) & 255] == flamey_count) continue; \
+            \
+            size_t flamey_offset = 0; \
+            \
+            for (size_t flamey_b = 0; flamey_b < 256; flamey_b++) \
+            { \
+                size_t flamey_bucket = flamey_digits[flamey_d][flamey_b]; \
+                \
+                flamey_digits[flamey_d][flamey_b] = flamey_offset; \
+                flamey_offset += flamey_bucket; \
+            } \
+            \
+            for (size_t flamey_i = 0; flamey_i < flamey_count; flamey_i++) \
+            { \
+                unsigned long long flamey_key = (unsigned long long) flamey_from[flamey_i] ^ flamey_flip; \
+                \
+                flamey_to[flamey_digits[flamey_d][(flamey_key >> (8 * flamey_d)) & 255]++] = flamey_from[flamey_i]; \
+            } \
+            \
+            flamey_item* flamey_swap = flamey_from; \
+            flamey_from = flamey_to; \
+            flamey_to = flamey_swap; \
+        } \
+        \
+        if (flamey_from != &(array)[start]) memcpy(&(array)[start], flamey_from, flamey_count * sizeof(flamey_item)); \
+        \
+        free(flamey_buffer); \
+    } \
+    \
+    flamey_buffer != nullptr; \
+})
+
+/**
+    * @brief Sorts an array that is made of a few sorted runs, by finding them (and reversing the descending ones), then merging them in pairs.
+    *           Gives up as soon as it finds more than one run every `FLAMEY_SORT_RUNLENGTH` elements.
+    *
+    *        ### The average user should not use this: use `sort()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+    * @param compare A comparison function.
+    *
+    * @return The number of runs that were found (`1` if the array was already sorted, after reversing it if it was descending), or `0` if it gave up
+    *           or there wasn't enough memory. When it returns `0`, the array isn't sorted yet, but it still has the same elements.
+*/
+#define flamey_runsort(array, start, end, compare) ( \
+{ \
+    typedef typeof(array[0]) flamey_item; \
+    \
+    size_t flamey_count = (end) - (start) + 1, flamey_limit = flamey_count / FLAMEY_SORT_RUNLENGTH + 1, flamey_found = 0; \
+    size_t* flamey_ends = malloc(flamey_limit * sizeof(size_t)); \
+    flamey_item* flamey_from = &(array)[start]; \
+    \
+    for (size_t flamey_i = 0; flamey_ends != nullptr && flamey_i < flamey_count; ) \
+    { \
+        size_t flamey_j = flamey_i; \
+        \
+        if (flamey_j + 1 < flamey_count && FLAMEY_COMPARE(FLAMEY_OP_SORT, compare, &flamey_from[flamey_j + 1], &flamey_from[flamey_j]) < 0) \
+        { \
+            while (flamey_j + 1 < flamey_count && FLAMEY_COMPARE(FLAMEY_OP_SORT, compare, &flamey_from[flamey_j + 1], &flamey_from[flamey_j]) < 0) flamey_j++; \
+            \
+            for (size_t flamey_low = flamey_i, flamey_high = flamey_j; flamey_low < flamey_high; flamey_low++, flamey_high--) \
+            { \
+                flamey_item flamey_other = flamey_from[flamey_low]; \
+                flamey_from[flamey_low] = flamey_from[flamey_high]; \
+                flamey_from[flamey_high] = flamey_other; \
+            } \
+        } \
+        else \
+        { \
+            while (flamey_j + 1 < flamey_count && FLAMEY_COMPARE(FLAMEY_OP_SORT, compare, &flamey_from[flamey_j + 1], &flamey_from[flamey_j]) >= 0) flamey_j++; \
+        } \
+        \
+        if (flamey_found == flamey_limit) \
+        { \
+            flamey_found = 0; \
+            break; \
+        } \
+        \
+        flamey_ends[flamey_found++] = flamey_j; \
+        flamey_i = flamey_j + 1; \
+    } \
+    \
+    flamey_item* flamey_buffer = flamey_found > 1 ? malloc(flamey_count * sizeof(flamey_item)) : nullptr; \
+    \
+    if (flamey_found > 1 && flamey_buffer == nullptr) flamey_found = 0; \
+    \
+    if (flamey_found > 1) \
+    { \
+        flamey_item* flamey_to = flamey_buffer; \
+        size_t flamey_runs = flamey_found; \
+        \
+        while (flamey_runs > 1) \
+        { \
+            size_t flamey_merged = 0; \
+            \
+            for (size_t flamey_r = 0; flamey_r < flamey_runs; flamey_r += 2) \
+            { \
+                size_t flamey_low = flamey_r == 0 ? 0 : flamey_ends[flamey_r - 1] + 1, flamey_middle = flamey_ends[flamey_r]; \
+                \
+                if (flamey_r + 1 == flamey_runs) \
+                { \
+                    memcpy(&flamey_to[flamey_low], &flamey_from[flamey_low], (flamey_middle - flamey_low + 1) * sizeof(flamey_item)); \
+                    flamey_ends[flamey_merged++] = flamey_middle; \
+                    continue; \
+                } \
+                \
+                size_t flamey_high = flamey_ends[flamey_r + 1], flamey_i = flamey_low, flamey_j = flamey_middle + 1, flamey_k = flamey_low; \
+                \
+                if (FLAMEY_COMPARE(FLAMEY_OP_SORT, compare, &flamey_from[flamey_j], &flamey_from[flamey_middle]) >= 0) \
+                { \
+                    memcpy(&flamey_to[flamey_low], &flamey_from[flamey_low], (flamey_high - flamey_low + 1) * sizeof(flamey_item)); \
+                } \
+                else \
+                { \
+                    while (flamey_i <= flamey_middle && flamey_j <= flamey_high) \
+                    { \
+                        if (FLAMEY_COMPARE(FLAMEY_OP_SORT, compare, &flamey_from[flamey_j], &flamey_from[flamey_i]) < 0) flamey_to[flamey_k++] = flamey_from[flamey_j++]; \
+                        else flamey_to[flamey_k++] = flamey_from[flamey_i++]; \
+                    } \
+                    \
+                    while (flamey_i <= flamey_middle) flamey_to[flamey_k++] = flamey_from[flamey_i++]; \
+                    while (flamey_j <= flamey_high) flamey_to[flamey_k++] = flamey_from[flamey_j++]; \
+                } \
+                \
+                FLAMEY_COUNT(FLAMEY_OP_SORT, bytes_moved, (flamey_high - flamey_low + 1) * sizeof(flamey_item)); \
+                flamey_ends[flamey_merged++] = flamey_high; \
+            } \
+            \
+            flamey_item* flamey_swap = flamey_from; \
+            flamey_from = flamey_to; \
+            flamey_to = flamey_swap; \
+            flamey_runs = flamey_merged; \
+        } \
+        \
+        if (flamey_from != &(array)[start]) memcpy(&(array)[start], flamey_from, flamey_count * sizeof(flamey_item)); \
+    } \
+    \
+    free(flamey_buffer); \
+    free(flamey_ends); \
+    \
+    flamey_found; \
+})
+
+/**
+    * @brief Sorts the structures of a view by their values: sorts the indices of the values with `argsort()`, then moves the structures with `permute()`.
+    *           Structures with equal values keep their order.
+    *
+    *        ### The average user should not use this: use `qsort()` or `sort()` with a view instead.
+    *
+    * @param view The view to sort.
+    * @param start The view index to start sorting from.
+    * @param end The view index to stop sorting at.
+    * @param compare A comparison function.
+    * @param funcname The calling macro's name, for the error message.
+*/
+#define flamey_viewsort(view, start, end, compare, funcname) ( \
+{ \
+    size_t flamey_rows = (end) - (start) + 1; \
+    size_t* flamey_order = malloc(flamey_rows * sizeof(size_t)); \
+    \
+    if (flamey_order == nullptr) \
+    { \
+        fprintf(stderr, "%s(): not enough memory to sort %zu elements.\n", funcname, flamey_rows); \
+        exit(EXIT_FAILURE); \
+    } \
+    \
+    argsort(flamey_order, view, start, end, compare); \
+    permute(flamey_order, start, end, (char*) (view).first - (view).offset, (view).stride); \
+    free(flamey_order); \
+})
+
+/**
+    * @brief Sorts an array, choosing the algorithm from its length, the type of its elements and how sorted it already is:
+    *           - Up to `FLAMEY_SORT_NETWORK` elements: a sorting network (see `sort_n()`).
+    *           - Up to `FLAMEY_SORT_INSERTION` elements: Insertion Sort.
+    *           - If `FLAMEY_SORT_SAMPLE` pairs of neighbouring elements, spread over the array, are (almost) all in order or all in reverse order:
+    *             the sorted runs are found and merged, which is O(n) for a sorted or reversed array.
+    *           - Integers sorted with an integer `ascending()` function: Counting Sort if the range of values is small, Radix Sort otherwise.
+    *           - Anything else: introsort, like `qsort()`.
+    *        Set `sorthook` to see what it chooses. Equal elements can end up in any order.
+    *
+    *        Example:
+    *```c
+    *sort(array, 0, 999, ascending);
+    *sort(names, 0, count - 1, string_ascending);
+    *```
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define sort(array, start, end, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_SORT); \
+    \
+    if (arrcheck(array, start, end, "sort")) \
+    { \
+        size_t flamey_length = (end) - (start) + 1, flamey_size = sizeof(flamey_at(array, 0)); \
+        typeof(&flamey_asarray(array)[0]) flamey_items = &flamey_asarray(array)[0], flamey_base = &flamey_items[start]; \
+        \
+        if (flamey_isview(array)) \
+        { \
+            flamey_sortchoice("view", flamey_length, flamey_size); \
+            flamey_viewsort(flamey_asview(array), start, end, compare, "sort"); \
+        } \
+        else if (flamey_length <= FLAMEY_SORT_NETWORK && flamey_length <= 8) \
+        { \
+            flamey_sortchoice("network", flamey_length, flamey_size); \
+            \
+            switch (flamey_length) \
+            { \
+                case 2: sort_n(flamey_base, 0, 2, compare); break; \
+                case 3: sort_n(flamey_base, 0, 3, compare); break; \
+                case 4: sort_n(flamey_base, 0, 4, compare); break; \
+                case 5: sort_n(flamey_base, 0, 5, compare); break; \
+                case 6: sort_n(flamey_base, 0, 6, compare); break; \
+                case 7: sort_n(flamey_base, 0, 7, compare); break; \
+                case 8: sort_n(flamey_base, 0, 8, compare); break; \
+            } \
+        } \
+        else if (flamey_length <= FLAMEY_SORT_INSERTION) \
+        { \
+            flamey_sortchoice("insertion", flamey_length, flamey_size); \
+            flamey_insertionsort(flamey_items, start, end, compare, FLAMEY_OP_SORT); \
+        } \
+        else \
+        { \
+            size_t flamey_ascents = 0, flamey_descents = 0, flamey_runs = 0; \
+            \
+            for (size_t flamey_k = 0; flamey_k < FLAMEY_SORT_SAMPLE; flamey_k++) \
+            { \
+                size_t flamey_i = flamey_k * (flamey_length - 1) / FLAMEY_SORT_SAMPLE; \
+                int flamey_order = FLAMEY_COMPARE(FLAMEY_OP_SORT, compare, &flamey_base[flamey_i], &flamey_base[flamey_i + 1]); \
+                \
+                flamey_ascents += flamey_order < 0; \
+                flamey_descents += flamey_order > 0; \
+            } \
+            \
+            if (flamey_descents <= FLAMEY_SORT_SAMPLE / 16 || flamey_ascents <= FLAMEY_SORT_SAMPLE / 16) \
+            { \
+                flamey_runs = flamey_runsort(flamey_items, start, end, compare); \
+            } \
+            \
+            if (flamey_runs == 1) \
+            { \
+                flamey_sortchoice(flamey_descents > flamey_ascents ? "reversed" : "sorted", flamey_length, flamey_size); \
+            } \
+            else if (flamey_runs > 1) \
+            { \
+                flamey_sortchoice("runs", flamey_length, flamey_size); \
+            } \
+            else if (flamey_isintegerexpr(flamey_items[0]) && flamey_isascending(compare) && flamey_length >= FLAMEY_SORT_RADIX) \
+            { \
+                typeof(flamey_radixkey(flamey_items[0]))* flamey_ints = (void*) flamey_base; \
+                typeof(flamey_radixkey(flamey_items[0])) flamey_min = flamey_ints[0], flamey_max = flamey_ints[0]; \
+                \
+                for (size_t flamey_i = 1; flamey_i < flamey_length; flamey_i++) \
+                { \
+                    flamey_min = flamey_ints[flamey_i] < flamey_min ? flamey_ints[flamey_i] : flamey_min; \
+                    flamey_max = flamey_ints[flamey_i] > flamey_max ? flamey_ints[flamey_i] : flamey_max; \
+                } \
+                \
+                if (flamey_countsort(flamey_ints, 0, flamey_length - 1, flamey_min, flamey_max)) \
+                { \
+                    flamey_sortchoice("counting", flamey_length, flamey_size); \
+                } \
+                else if (flamey_radixsort(flamey_ints, 0, flamey_length - 1)) \
+                { \
+                    flamey_sortchoice("radix", flamey_length, flamey_size); \
+                } \
+                else \
+                { \
+                    flamey_sortchoice("introsort", flamey_length, flamey_size); \
+                    flamey_introsort(flamey_items, start, end, compare, FLAMEY_OP_SORT); \
+                } \
+            } \
+            else \
+            { \
+                flamey_sortchoice("introsort", flamey_length, flamey_size); \
+                flamey_introsort(flamey_items, start, end, compare, FLAMEY_OP_SORT); \
+            } \
+        } \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_SORT); \
+})
+
+/**
+    * @brief Sorts an array using the Quick Sort algorithm.
+    *           Partitions the array around a pivot element, then recursively sorts the left and right subarrays.
+    *           Falls back to Heap Sort if the partitions get too unbalanced, and uses Insertion Sort for small partitions (introsort).
+    *           Unlike `stdlib.h`'s `qsort()`, `compare` is called directly: with a comparison function made by `FLAMEY_CMP_DEFINE()`, it gets inlined.
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define qsort(array, start, end, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_QSORT); \
+    \
+    if (arrcheck(array, start, end, "qsort")) \
+    { \
+        if (flamey_isview(array)) flamey_viewsort(flamey_asview(array), start, end, compare, "qsort"); \
+        else flamey_introsort(flamey_asarray(array), start, end, compare, FLAMEY_OP_QSORT); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_QSORT); \
+})
+
+/*
+    Segmented sort: `segsort()` sorts many small arrays stored one after the other in the same buffer, in one call.
+    The indices are checked once for the whole buffer instead of once per array, and the arrays are shared between the threads of the pool
+    in batches of about `FLAMEY_SEGSORT_BATCH` elements (so a batch of many tiny arrays costs about as much as a batch of a few bigger ones).
+*/
+
+/**
+    * @brief Number of elements in a batch of segments given to a thread by `segsort()`. Can be defined before including this header.
+*/
+#ifndef FLAMEY_SEGSORT_BATCH
+#define FLAMEY_SEGSORT_BATCH 32768
+#endif
+
+/**
+    * @brief Segments of up to this many elements are sorted by `segsort()` with a sorting network (at most `16`). Can be defined before including this header.
+*/
+#ifndef FLAMEY_SEGSORT_NETWORK
+#define FLAMEY_SEGSORT_NETWORK 8
+#endif
+
+/**
+    * @brief Finds the first segment that starts at or after `position`, with Binary Search. Used by `segsort()` to cut the segments into batches.
+    *
+    *        ### The average user should not use this: use `segsort()` instead.
+    *
+    * @param offsets The offsets of the segments.
+    * @param segments The number of segments.
+    * @param position The array index.
+    *
+    * @return The index of the segment, or `segments` if they all start before `position`.
+*/
+static inline size_t flamey_segmentat(const size_t* offsets, size_t segments, size_t position)
+{
+    size_t low = 0, high = segments;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (offsets[middle] < position) low = middle + 1;
+        else high = middle;
+    }
+
+    return low;
+}
+
+/**
+    * @brief What `segsort()`'s file-scope chunk function works on, in unoptimized builds (see `flamey_nestedfor()`).
+    *
+    *        ### The average user should not use this.
+*/
+typedef struct flamey_segwork
+{
+    char* items;
+    const size_t* offsets;
+    size_t segments;
+    size_t batch;
+    size_t size;
+    int (*compare)(const void*, const void*);
+} flamey_segwork;
+
+/**
+    * @brief `segsort()`'s file-scope chunk function: sorts the segments that start in a range of batches with `stdlib.h`'s `qsort()`,
+    *           which takes the comparison function as a pointer, so it works for any element type without a nested function (and its trampoline).
+    *
+    *        ### The average user should not use this: use `segsort()` instead.
+*/
+static inline void flamey_segsortwork(size_t low, size_t high, void* data)
+{
+    flamey_segwork* work = data;
+    size_t first = low == 0 ? 0 : flamey_segmentat(work->offsets, work->segments, work->offsets[0] + low * work->batch);
+    size_t last = flamey_segmentat(work->offsets, work->segments, work->offsets[0] + (high + 1) * work->batch);
+
+    for (size_t k = first; k < last; k++)
+    {
+        size_t length = work->offsets[k + 1] - work->offsets[k];
+
+        if (length > 1) (qsort)(work->items + work->offsets[k] * work->size, length, work->size, work->compare);
+    }
+}
+
+/**
+    * @brief Sorts one segment for `segsort()`, without checking the array indices: a sorting network up to `FLAMEY_SEGSORT_NETWORK` elements,
+    *           introsort (which is Insertion Sort for up to 17 elements) below `FLAMEY_SORT_RADIX` elements, and `sort()` for bigger segments.
+    *
+    *        ### The average user should not use this: use `segsort()` instead.
+    *
+    * @param items Pointer to the first element of the buffer.
+    * @param first The index of the first element of the segment.
+    * @param next The index after the last element of the segment.
+    * @param compare A comparison function.
+*/
+#define flamey_segsortone(items, first, next, compare) ( \
+{ \
+    size_t flamey_seglength = (next) - (first); \
+    typeof(&(items)[0]) flamey_segbase = &(items)[first]; \
+    \
+    if (flamey_seglength <= FLAMEY_SEGSORT_NETWORK && flamey_seglength <= 16) \
+    { \
+        switch (flamey_seglength) \
+        { \
+            case 2: sort_n(flamey_segbase, 0, 2, compare); break; \
+            case 3: sort_n(flamey_segbase, 0, 3, compare); break; \
+            case 4: sort_n(flamey_segbase, 0, 4, compare); break; \
+            case 5: sort_n(flamey_segbase, 0, 5, compare); break; \
+            case 6: sort_n(flamey_segbase, 0, 6, compare); break; \
+            case 7: sort_n(flamey_segbase, 0, 7, compare); break; \
+            case 8: sort_n(flamey_segbase, 0, 8, compare); break; \
+            case 9: sort_n(flamey_segbase, 0, 9, compare); break; \
+            case 10: sort_n(flamey_segbase, 0, 10, compare); break; \
+            case 11: sort_n(flamey_segbase, 0, 11, compare); break; \
+            case 12: sort_n(flamey_segbase, 0, 12, compare); break; \
+            case 13: sort_n(flamey_segbase, 0, 13, compare); break; \
+            case 14: sort_n(flamey_segbase, 0, 14, compare); break; \
+            case 15: sort_n(flamey_segbase, 0, 15, compare); break; \
+            case 16: sort_n(flamey_segbase, 0, 16, compare); break; \
+        } \
+    } \
+    else if (flamey_seglength < FLAMEY_SORT_RADIX) \
+    { \
+        flamey_introsort(flamey_segbase, 0, flamey_seglength - 1, compare, FLAMEY_OP_SEGSORT); \
+    } \
+    else \
+    { \
+        sort(flamey_segbase, 0, flamey_seglength - 1, compare); \
+    } \
+})
+
+/**
+    * @brief Sorts many segments of an array, each on its own, in parallel. Segment `k` goes from `array[offsets[k]]` to `array[offsets[k + 1] - 1]`,
+    *           so `offsets` has `segments + 1` values, in ascending order (segments can be empty).
+    *           Much faster than calling `qsort()` once per segment when there are many small ones.
+    *
+    *        Example:
+    *```c
+    *int scores[] = { 7, 3, 9,   4, 1,   8, 6, 2, 5 };
+    *size_t offsets[] = { 0, 3, 5, 9 };
+    *
+    *segsort(scores, offsets, 3, ascending); // { 3, 7, 9,   1, 4,   2, 5, 6, 8 }
+    *```
+    *
+    * @param array The buffer with all the segments.
+    * @param offsets The index of the first element of each segment, then the index after the last one.
+    * @param segments The number of segments.
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define segsort(array, offsets, segments, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_SEGSORT); \
+    \
+    const size_t* flamey_offsets = &(offsets)[0]; \
+    size_t flamey_segments = segments; \
+    \
+    if (flamey_segments > 0 && arrcheck(flamey_offsets, 0, flamey_segments, "segsort") && \
+        flamey_offsets[flamey_segments] > flamey_offsets[0] && arrcheck(array, flamey_offsets[0], flamey_offsets[flamey_segments] - 1, "segsort")) \
+    { \
+        size_t flamey_total = flamey_offsets[flamey_segments] - flamey_offsets[0]; \
+        size_t flamey_batches = (flamey_total + FLAMEY_SEGSORT_BATCH - 1) / FLAMEY_SEGSORT_BATCH; \
+        \
+        struct flamey_segcontext { typeof(&(array)[0]) flamey_items; const size_t* flamey_offs; size_t flamey_segs; size_t flamey_batch; typeof(&*(compare)) flamey_compare; } flamey_context = \
+            { &(array)[0], flamey_offsets, flamey_segments, (flamey_total + flamey_batches - 1) / flamey_batches, &*(compare) }; \
+        \
+        void flamey_segchunk(size_t flamey_low, size_t flamey_high, void* flamey_data) \
+        { \
+            struct flamey_segcontext* flamey_chunk = flamey_data; \
+            const size_t* flamey_bounds = flamey_chunk->flamey_offs; \
+            size_t flamey_first = flamey_low == 0 ? 0 : flamey_segmentat(flamey_bounds, flamey_chunk->flamey_segs, flamey_bounds[0] + flamey_low * flamey_chunk->flamey_batch); \
+            size_t flamey_last = flamey_segmentat(flamey_bounds, flamey_chunk->flamey_segs, flamey_bounds[0] + (flamey_high + 1) * flamey_chunk->flamey_batch); \
+            \
+            for (size_t flamey_k = flamey_first; flamey_k < flamey_last; flamey_k++) \
+            { \
+                if (flamey_bounds[flamey_k + 1] - flamey_bounds[flamey_k] > 1) \
+                    flamey_segsortone(flamey_chunk->flamey_items, flamey_bounds[flamey_k], flamey_bounds[flamey_k + 1], flamey_direct(compare, flamey_chunk->flamey_compare)); \
+            } \
+        } \
+        \
+        flamey_nestedfor(0, flamey_batches - 1, 1, flamey_segchunk, &flamey_context, &flamey_segsortwork, \
+            (&(flamey_segwork) { (char*) flamey_context.flamey_items, flamey_offsets, flamey_segments, flamey_context.flamey_batch, sizeof((array)[0]), \
+                                 (int (*)(const void*, const void*)) flamey_context.flamey_compare })); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_SEGSORT); \
+})
+
+/**
+    * @brief Sorts an array of null-terminated strings (`char*`) with Multikey Quick Sort, in `strcmp()` order.
+    *           The next 8 bytes of every string are cached next to its pointer and compared as one number, so shared prefixes are only read once
+    *           per 8 bytes, instead of again in every comparison like with `qsort()` and `string_ascending()`. Strings that are equal can end up in any order.
+    * 
+    * @param array The array of strings to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param ignorecase If `true`, letters are compared like `lowercase()` would make them, in `string_nocase_ascending()` order.
+*/
+FLAMEY_DEF void strsort
+(
+    char* array[],
+    size_t start,
+    size_t end,
+    bool ignorecase
+);
+
+/*
+    Counting sort, for integers whose values fit in a small range (like the ones made by `randints()`).
+    It counts how many times each value appears, then writes the values back in order: O(n + range) instead of O(n log n).
+    If the range is too big (more than `FLAMEY_COUNTSORT_MAX` values, or a lot more values than elements), it falls back to a comparison sort.
+*/
+
+/**
+    * @brief Largest number of different values that the counting sorts count. Can be defined before including this header.
+*/
+#ifndef FLAMEY_COUNTSORT_MAX
+#define FLAMEY_COUNTSORT_MAX 4194304
+#endif
+
+#define flamey_isinteger(type) ((type) 0.5 == 0)
+#define flamey_countsortfits(span, count) ((span) < FLAMEY_COUNTSORT_MAX && (span) < 4 * (unsigned long long) (count) + 1024)
+
+/**
+    * @brief Sorts an array of integers with Counting Sort, if all values are between `low` and `high` and the range is small enough.
+    *
+    *        ### The average user should not use this: use `csort()` or `csortrange()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+    * @param low The smallest value.
+    * @param high The biggest value.
+    *
+    * @return `true` if the array was sorted, `false` if it wasn't touched.
+*/
+#define flamey_countsort(array, start, end, low, high) ( \
+{ \
+    typeof(array[0]) flamey_low = (low); \
+    unsigned long long flamey_span = (unsigned long long) (high) - (unsigned long long) flamey_low; \
+    size_t* flamey_counts = nullptr; \
+    bool flamey_sorted = false; \
+    \
+    if (flamey_countsortfits(flamey_span, (end) - (start) + 1)) flamey_counts = calloc(flamey_span + 1, sizeof(size_t)); \
+    \
+    if (flamey_counts != nullptr) \
+    { \
+        flamey_sorted = true; \
+        \
+        for (size_t flamey_i = (start); flamey_i <= (end); flamey_i++) \
+        { \
+            unsigned long long flamey_slot = (unsigned long long) (array)[flamey_i] - (unsigned long long) flamey_low; \
+            \
+            if (flamey_slot > flamey_span) \
+            { \
+                flamey_sorted = false; \
+                break; \
+            } \
+            \
+            flamey_counts[flamey_slot]++; \
+        } \
+        \
+        if (flamey_sorted) \
+        { \
+            size_t flamey_k = (start); \
+            \
+            for (unsigned long long flamey_value = 0; flamey_value <= flamey_span; flamey_value++) \
+            { \
+                for (size_t flamey_copies = flamey_counts[flamey_value]; flamey_copies > 0; flamey_copies--) \
+                { \
+                    (array)[flamey_k++] = (typeof(array[0])) ((unsigned long long) flamey_low + flamey_value); \
+                } \
+            } \
+            \
+            FLAMEY_COUNT(FLAMEY_OP_CSORT, bytes_moved, 2 * ((end) - (start) + 1) * sizeof(array[0])); \
+        } \
+        \
+        free(flamey_counts); \
+    } \
+    \
+    flamey_sorted; \
+})
+
+/**
+    * @brief Same as `csort()`, but without checking the array indices. Used by macros that already checked them.
+    *
+    *        ### The average user should not use this: use `csort()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+*/
+#define csort_unchecked(array, start, end) ( \
+{ \
+    typeof(array[0]) flamey_min = (array)[start], flamey_max = (array)[start]; \
+    \
+    for (size_t flamey_i = (start) + 1; flamey_i <= (end); flamey_i++) \
+    { \
+        flamey_min = (array)[flamey_i] < flamey_min ? (array)[flamey_i] : flamey_min; \
+        flamey_max = (array)[flamey_i] > flamey_max ? (array)[flamey_i] : flamey_max; \
+    } \
+    \
+    if (!flamey_countsort(array, start, end, flamey_min, flamey_max)) \
+    { \
+        int flamey_countcompare(const typeof(array[0])* flamey_a, const typeof(array[0])* flamey_b) \
+        { \
+            return (*flamey_a > *flamey_b) - (*flamey_a < *flamey_b); \
+        } \
+        \
+        flamey_introsort(array, start, end, flamey_countcompare, FLAMEY_OP_CSORT); \
+    } \
+})
+
+/**
+    * @brief Sorts an array of integers in ascending order using the Counting Sort algorithm.
+    *           Finds the smallest and biggest values in one pass, then counts how many times each value appears.
+    *           Falls back to `qsort()` if the range of values is too big.
+    *
+    * @param array The array of integers to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+*/
+#define csort(array, start, end) ( \
+{ \
+    _Static_assert(flamey_isinteger(typeof(array[0])), "csort() can only sort integers."); \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_CSORT); \
+    \
+    if (arrcheck(array, start, end, "csort")) csort_unchecked(array, start, end); \
+    \
+    FLAMEY_END(FLAMEY_OP_CSORT); \
+})
+
+/**
+    * @brief Same as `csort()`, but the range of values is already known, so there's no pass to find it.
+    *           Values outside of the range are still sorted correctly, but more slowly.
+    *
+    *        Example:
+    *```c
+    *randints(array, 0, 999, 0, 100);
+    *csortrange(array, 0, 999, 0, 100);
+    *```
+    *
+    * @param array The array of integers to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param min The smallest value in the array.
+    * @param max The biggest value in the array.
+*/
+#define csortrange(array, start, end, min, max) ( \
+{ \
+    _Static_assert(flamey_isinteger(typeof(array[0])), "csortrange() can only sort integers."); \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_CSORT); \
+    \
+    if (arrcheck(array, start, end, "csortrange") && !flamey_countsort(array, start, end, min, max)) csort_unchecked(array, start, end); \
+    \
+    FLAMEY_END(FLAMEY_OP_CSORT); \
+})
+
+/**
+    * @brief Sorts an array by an integer key with a stable sort: elements with the same key keep their order.
+    *           Uses Key-Indexed Counting if the keys fit in a small range (`low` to `high`), and Merge Sort otherwise.
+    *
+    *        ### The average user should not use this: use `ksort()` or `ksortrange()` instead.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from.
+    * @param end The array index to stop sorting at.
+    * @param key A function or macro that takes a pointer to an element and returns its integer key.
+    * @param low The smallest key.
+    * @param high The biggest key.
+*/
+#define flamey_keysort(array, start, end, key, low, high) ( \
+{ \
+    typedef typeof(array[0]) flamey_item; \
+    typedef typeof(key(&(array)[0])) flamey_key; \
+    \
+    size_t flamey_count = (end) - (start) + 1; \
+    flamey_key flamey_low = (low); \
+    unsigned long long flamey_span = (unsigned long long) (high) - (unsigned long long) flamey_low; \
+    flamey_item* flamey_buffer = malloc(flamey_count * sizeof(flamey_item)); \
+    size_t* flamey_counts = nullptr; \
+    \
+    if (flamey_buffer == nullptr) \
+    { \
+        fprintf(stderr, "ksort(): not enough memory to sort %zu elements.\n", flamey_count); \
+        exit(EXIT_FAILURE); \
+    } \
+    \
+    if (flamey_countsortfits(flamey_span, flamey_count)) flamey_counts = calloc(flamey_span + 1, sizeof(size_t)); \
+    \
+    for (size_t flamey_i = (start); flamey_counts != nullptr && flamey_i <= (end); flamey_i++) \
+    { \
+        unsigned long long flamey_slot = (unsigned long long) key(&(array)[flamey_i]) - (unsigned long long) flamey_low; \
+        \
+        if (flamey_slot > flamey_span) \
+        { \
+            free(flamey_counts); \
+            flamey_counts = nullptr; \
+        } \
+        else \
+        { \
+            flamey_counts[flamey_slot]++; \
+        } \
+    } \
+    \
+    if (flamey_counts != nullptr) \
+    { \
+        exscansum(flamey_counts, 0, flamey_span); \
+        \
+        for (size_t flamey_i = (start); flamey_i <= (end); flamey_i++) \
+        { \
+            flamey_buffer[flamey_counts[(unsigned long long) key(&(array)[flamey_i]) - (unsigned long long) flamey_low]++] = (array)[flamey_i]; \
+        } \
+        \
+        memcpy(&(array)[start], flamey_buffer, flamey_count * sizeof(flamey_item)); \
+        free(flamey_counts); \
+        FLAMEY_COUNT(FLAMEY_OP_KSORT, bytes_moved, 2 * flamey_count * sizeof(flamey_item)); \
+    } \
+    else \
+    { \
+        flamey_item* flamey_from = &(array)[start]; \
+        flamey_item* flamey_to = flamey_buffer; \
+        \
+        for (size_t flamey_first = 0; flamey_first < flamey_count; flamey_first += 16) \
+        { \
+            size_t flamey_last = flamey_count - flamey_first < 16 ? flamey_count : flamey_first + 16; \
+            \
+            for (size_t flamey_i = flamey_first + 1; flamey_i < flamey_last; flamey_i++) \
+            { \
+                flamey_item flamey_item = flamey_from[flamey_i]; \
+                size_t flamey_j = flamey_i; \
+                \
+                while (flamey_j > flamey_first && key(&flamey_item) < key(&flamey_from[flamey_j - 1])) \
+                { \
+                    flamey_from[flamey_j] = flamey_from[flamey_j - 1]; \
+                    flamey_j--; \
+                } \
+                \
+                flamey_from[flamey_j] = flamey_item; \
+            } \
+        } \
+        \
+        for (size_t flamey_width = 16; flamey_width < flamey_count; flamey_width *= 2) \
+        { \
+            for (size_t flamey_left = 0; flamey_left < flamey_count; flamey_left += 2 * flamey_width) \
+            { \
+                size_t flamey_middle = flamey_count - flamey_left < flamey_width ? flamey_count : flamey_left + flamey_width; \
+                size_t flamey_right = flamey_count - flamey_middle < flamey_width ? flamey_count : flamey_middle + flamey_width; \
+                size_t flamey_i = flamey_left, flamey_j = flamey_middle, flamey_k = flamey_left; \
+                \
+                while (flamey_i < flamey_middle && flamey_j < flamey_right) flamey_to[flamey_k++] = key(&flamey_from[flamey_j]) < key(&flamey_from[flamey_i]) ? flamey_from[flamey_j++] : flamey_from[flamey_i++]; \
+                while (flamey_i < flamey_middle) flamey_to[flamey_k++] = flamey_from[flamey_i++]; \
+                while (flamey_j < flamey_right) flamey_to[flamey_k++] = flamey_from[flamey_j++]; \
+            } \
+            \
+            flamey_item* flamey_swap = flamey_from; \
+            flamey_from = flamey_to; \
+            flamey_to = flamey_swap; \
+            FLAMEY_COUNT(FLAMEY_OP_KSORT, bytes_moved, flamey_count * sizeof(flamey_item)); \
+        } \
+        \
+        if (flamey_from != &(array)[start]) memcpy(&(array)[start], flamey_from, flamey_count * sizeof(flamey_item)); \
+    } \
+    \
+    free(flamey_buffer); \
+})
+
+/**
+    * @brief Sorts an array of records (like structs) by an integer key, in ascending order. The sort is stable: records with the same key keep their order.
+    *           Finds the smallest and biggest keys in one pass, then uses Key-Indexed Counting, which is O(n + range).
+    *           Falls back to Merge Sort if the range of keys is too big.
+    *
+    *        Example:
+    *```c
+    *#define age_of(person) ((person)->age)
+    *ksort(people, 0, count - 1, age_of);
+    *```
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param key A function or macro that takes a pointer to an element and returns its integer key.
+*/
+#define ksort(array, start, end, key) ( \
+{ \
+    _Static_assert(flamey_isinteger(typeof(key(&(array)[0]))), "ksort(): `key` must return an integer."); \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_KSORT); \
+    \
+    if (arrcheck(array, start, end, "ksort")) \
+    { \
+        typeof(key(&(array)[0])) flamey_min = key(&(array)[start]), flamey_max = flamey_min; \
+        \
+        for (size_t flamey_i = (start) + 1; flamey_i <= (end); flamey_i++) \
+        { \
+            typeof(key(&(array)[0])) flamey_value = key(&(array)[flamey_i]); \
+            \
+            flamey_min = flamey_value < flamey_min ? flamey_value : flamey_min; \
+            flamey_max = flamey_value > flamey_max ? flamey_value : flamey_max; \
+        } \
+        \
+        flamey_keysort(array, start, end, key, flamey_min, flamey_max); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_KSORT); \
+})
+
+/**
+    * @brief Same as `ksort()`, but the range of keys is already known, so there's no pass to find it.
+    *           Keys outside of the range are still sorted correctly, but more slowly.
+    *
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param key A function or macro that takes a pointer to an element and returns its integer key.
+    * @param min The smallest key.
+    * @param max The biggest key.
+*/
+#define ksortrange(array, start, end, key, min, max) ( \
+{ \
+    _Static_assert(flamey_isinteger(typeof(key(&array[0]))), "ksortrange(): `key` must return an integer."); \
+    \
+    FLAMEY_BEGIN(FLAMEY_OP_KSORT); \
+    \
+    if (arrcheck(array, start, end, "ksortrange")) flamey_keysort(array, start, end, key, min, max); \
+    \
+    FLAMEY_END(FLAMEY_OP_KSORT); \
+})
+
+/**
+    * @brief Fills an array of indices with the order that would sort an array, without moving the array itself (`array[indices[0]]` is the first element, ...).
+    *           The sort is stable: equal elements keep their order. Integers sorted with an `_ascending()` function of this header use `ksort()`
+    *           (Counting Sort if the values fit in a small range, Merge Sort otherwise), and everything else uses `qsort()`.
+    *           The keys are copied next to their indices before sorting, so the sort doesn't jump around in memory.
+    *
+    *        Example (sorting "columns" by one of them):
+    *```c
+    *size_t order[COUNT];
+    *argsort(order, ages, 0, COUNT - 1, ascending);
+    *apply_permutation(order, 0, COUNT - 1, ages, names, heights);
+    *```
+    *
+    * @param indices The array of indices to fill, as long as the range (`indices[0]` is the index in `array` of the first element, ...).
+    * @param array The array to sort by.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define argsort(indices, array, start, end, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_ARGSORT); \
+    \
+    if (arrcheck(array, start, end, "argsort")) \
+    { \
+        typedef struct flamey_pair { flamey_unqual(flamey_at(array, 0)) key; size_t index; } flamey_pair; \
+        \
+        size_t flamey_rows = (end) - (start) + 1; \
+        flamey_pair* flamey_pairs = malloc(flamey_rows * sizeof(flamey_pair)); \
+        \
+        if (flamey_pairs == nullptr) \
+        { \
+            fprintf(stderr, "argsort(): not enough memory to sort %zu elements.\n", flamey_rows); \
+            exit(EXIT_FAILURE); \
+        } \
+        \
+        for (size_t flamey_i = 0; flamey_i < flamey_rows; flamey_i++) \
+        { \
+            flamey_pairs[flamey_i].key = flamey_at(array, (start) + flamey_i); \
+            flamey_pairs[flamey_i].index = (start) + flamey_i; \
+        } \
+        \
+        if (flamey_isintegerexpr(flamey_at(array, 0)) && flamey_isascending(compare)) \
+        { \
+            ksort(flamey_pairs, 0, flamey_rows - 1, flamey_pairkey); \
+        } \
+        else \
+        { \
+            int flamey_paircompare(const flamey_pair* flamey_a, const flamey_pair* flamey_b) \
+            { \
+                int flamey_order = (*compare)(&flamey_a->key, &flamey_b->key); \
+                \
+                return flamey_order != 0 ? flamey_order : (flamey_a->index > flamey_b->index) - (flamey_a->index < flamey_b->index); \
+            } \
+            \
+            flamey_introsort(flamey_pairs, 0, flamey_rows - 1, flamey_paircompare, FLAMEY_OP_ARGSORT); \
+        } \
+        \
+        for (size_t flamey_i = 0; flamey_i < flamey_rows; flamey_i++) \
+        { \
+            (indices)[flamey_i] = flamey_pairs[flamey_i].index; \
+        } \
+        \
+        free(flamey_pairs); \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_ARGSORT); \
+})
+
+#define flamey_isintegerexpr(value) (__builtin_classify_type(value) >= 1 && __builtin_classify_type(value) <= 4)
+#define flamey_pairkey(pair) __builtin_choose_expr(flamey_isintegerexpr((pair)->key), (pair)->key, 0)
+
+/**
+    * @brief Reorders an array with an array of indices: the element at `start + k` becomes the one that was at `indices[k]`.
+    *           Gathers the elements into a buffer (with prefetching, and with all the threads of the pool for big arrays), then copies them back.
+    *           If there isn't enough memory for the buffer, follows the cycles of the permutation instead, which needs no buffer but is slower.
+    *
+    *        ### The average user should not use this: use `apply_permutation()` instead.
+    *
+    * @param indices The indices, as filled by `argsort()`. Must contain every index from `start` to `end` exactly once.
+    * @param start The array index to start reordering from.
+    * @param end The array index to stop reordering at.
+    * @param array The array to reorder.
+    * @param size The size of an element of the array, in bytes.
+*/
+FLAMEY_DEF void permute
+(
+    const size_t* indices,
+    size_t start,
+    size_t end,
+    void* array,
+    size_t size
+);
+
+#define flamey_nargs(...) flamey_nargs_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define flamey_nargs_(a1, a2, a3, a4, a5, a6, a7, a8, count, ...) count
+#define flamey_concat(a, b) flamey_concat_(a, b)
+#define flamey_concat_(a, b) a##b
+#define flamey_foreach(macro, ...) flamey_concat(flamey_foreach_, flamey_nargs(__VA_ARGS__))(macro, __VA_ARGS__)
+#define flamey_foreach_1(macro, a) macro(a)
+#define flamey_foreach_2(macro, a, ...) macro(a) flamey_foreach_1(macro, __VA_ARGS__)
+#define flamey_foreach_3(macro, a, ...) macro(a) flamey_foreach_2(macro, __VA_ARGS__)
+#define flamey_foreach_4(macro, a, ...) macro(a) flamey_foreach_3(macro, __VA_ARGS__)
+#define flamey_foreach_5(macro, a, ...) macro(a) flamey_foreach_4(macro, __VA_ARGS__)
+#define flamey_foreach_6(macro, a, ...) macro(a) flamey_foreach_5(macro, __VA_ARGS__)
+#define flamey_foreach_7(macro, a, ...) macro(a) flamey_foreach_6(macro, __VA_ARGS__)
+#define flamey_foreach_8(macro, a, ...) macro(a) flamey_foreach_7(macro, __VA_ARGS__)
+
+#define flamey_permuteone(array) permute(flamey_indices, flamey_start, flamey_end, &(array)[0], sizeof((array)[0]));
+
+/**
+    * @brief Reorders up to 8 arrays with the same array of indices (made by `argsort()`): in each array, the element at `start + k` becomes the one that was at `indices[k]`.
+    *           Useful to sort "columns" (one array per field) by one of them. The arrays can have different types.
+    *
+    * @param indices The indices, as filled by `argsort()`. Must contain every index from `start` to `end` exactly once.
+    * @param start The array index to start reordering from (`0` to start from the beginning).
+    * @param end The array index to stop reordering at (array length - 1 to finish at the end).
+    * @param ... The arrays to reorder (up to 8).
+*/
+#define apply_permutation(indices, start, end, ...) ( \
+{ \
+    const size_t* flamey_indices = &(indices)[0]; \
+    size_t flamey_start = start, flamey_end = end; \
+    \
+    if (arrcheck(flamey_indices, flamey_start, flamey_end, "apply_permutation")) \
+    { \
+        flamey_foreach(flamey_permuteone, __VA_ARGS__) \
+    } \
+})
+
+/**
+    * @brief Finds an element in a sorted array, using Binary Search.
+    *           `compare` is called directly: with a comparison function made by `FLAMEY_CMP_DEFINE()`, it gets inlined.
+    *
+    * @param array The sorted array to search.
+    * @param start The array index to start searching from (`0` to start from the beginning).
+    * @param end The array index to stop searching at (array length - 1 to finish at the end).
+    * @param key The value to look for.
+    * @param compare The comparison function the array was sorted with.
+    *
+    * @return The index of the first element equal to `key`, or `npos` if there isn't one.
+*/
+#define binsearch(array, start, end, key, compare) ( \
+{ \
+    size_t flamey_found = npos; \
+    \
+    if (arrcheck(array, start, end, "binsearch")) \
+    { \
+        flamey_unqual(flamey_at(array, 0)) flamey_wanted = key; \
+        size_t flamey_low = start, flamey_high = (size_t) (end) + 1; \
+        \
+        while (flamey_low < flamey_high) \
+        { \
+            size_t flamey_middle = flamey_low + (flamey_high - flamey_low) / 2; \
+            \
+            if ((*compare)(&flamey_at(array, flamey_middle), &flamey_wanted) < 0) flamey_low = flamey_middle + 1; \
+            else flamey_high = flamey_middle; \
+        } \
+        \
+        if (flamey_low <= (size_t) (end) && (*compare)(&flamey_at(array, flamey_low), &flamey_wanted) == 0) flamey_found = flamey_low; \
+    } \
+    \
+    flamey_found; \
+})
+
+/**
+    * @brief Sorts an array using the Bubble Sort algorithm.
+    *           Checks two items at a time: if they aren't in order, swaps them. Iterates over the array until it is all sorted.
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define bsort(array, start, end, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_BSORT); \
+    \
+    if (arrcheck(array, start, end, "bsort")) \
+    { \
+        for (size_t i = start; i < end; i++) \
+        { \
+            for (size_t j = start; j < end - i; j++) \
+            { \
+                if (FLAMEY_COMPARE(FLAMEY_OP_BSORT, compare, &array[j], &array[j + 1]) > 0) \
+                { \
+                    swap(&array[j], &array[j + 1], sizeof(array[0])); \
+                    FLAMEY_COUNT_SWAP(FLAMEY_OP_BSORT, sizeof(array[0])); \
+                } \
+            } \
+        } \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_BSORT); \
+})
+
+/**
+    * @brief Sorts an array using the Gnome Sort algorithm.
+    *           Reads through the array. When it finds an unsorted item, it runs through the previously read items to find the place to put it.
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define gsort(array, start, end, compare) ( \
+{ \
+    FLAMEY_BEGIN(FLAMEY_OP_GSORT); \
+    \
+    if (arrcheck(array, start, end, "gsort")) \
+    { \
+        for (size_t i = start + 1; i <= end; i++) \
+        { \
+            if (FLAMEY_COMPARE(FLAMEY_OP_GSORT, compare, &array[i - 1], &array[i]) > 0) \
+            { \
+                for (size_t j = start; j < i; j++) \
+                { \
+                    if (!(FLAMEY_COMPARE(FLAMEY_OP_GSORT, compare, &array[i], &array[j]) > 0)) \
+                    { \
+                        swap(&array[i], &array[j], sizeof(array[0])); \
+                        FLAMEY_COUNT_SWAP(FLAMEY_OP_GSORT, sizeof(array[0])); \
+                    } \
+                } \
+            } \
+        } \
+    } \
+    \
+    FLAMEY_END(FLAMEY_OP_GSORT); \
+})
+
+/**
+    * @brief "Sorts" an array using the Bogosort *joke* algorithm.
+    *           Shuffles the list. If it isn't sorted, shuffle again.
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define bogosort(array, start, end, compare) ( \
+{ \
+    if (arrcheck(array, start, end, "bogosort")) \
+    { \
+        while (!is_sorted_unchecked(array, start, end, compare)) \
+        { \
+            shuffle_unchecked(array, start, end); \
+        } \
+    } \
+})
+
+/**
+    * @brief "Sorts" an array using the Miracle Sort *joke* algorithm. Do not use this.
+    *           Constantly checks if the list has been sorted by a cosmic ray causing a bit flip.
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param end The array index to stop sorting at (array length - 1 to finish at the end).
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define mrclsort(array, start, end, compare) ( \
+{ \
+    if (arrcheck(array, start, end, "mrclsort")) \
+    { \
+        while (!(is_sorted_unchecked(array, start, end, compare))) {} \
+    } \
+})
+
+/*
+    SORTED ARRAY FUNCTIONS
+*/
+
+/*
+    These functions take arrays that are already sorted with the same `compare` function (by `qsort()`, for example),
+    and write their result at the beginning of `dest`, which must be big enough and must not overlap the other arrays.
+    They return the number of elements written to `dest`.
+*/
+
+/**
+    * @brief Merges two sorted arrays into one sorted array. Equal elements keep their order, and the ones from `first` come first.
+    *
+    * @param dest The destination array (at least as long as both ranges together).
+    * @param first The first sorted array.
+    * @param firststart The array index to start reading `first` from (`0` to start from the beginning).
+    * @param firstend The array index to stop reading `first` at (array length - 1 to finish at the end).
+    * @param second The second sorted array.
+    * @param secondstart The array index to start reading `second` from (`0` to start from the beginning).
+    * @param secondend The array index to stop reading `second` at (array length - 1 to finish at the end).
+    * @param compare The comparison function the arrays are sorted with.
+    *
+    * @return The number of elements written to `dest`.
+*/
+#define merge(dest, first, firststart, firstend, second, secondstart, secondend, compare) ( \
+{ \
+    size_t flamey_written = 0; \
+    \
+    if (arrcheck(first, firststart, firstend, "merge") && arrcheck(second, secondstart, secondend, "merge")) \
+    { \
+        size_t flamey_i = firststart, flamey_j = secondstart; \
+        \
+        while (flamey_i <= (size_t) (firstend) && flamey_j <= (size_t) (secondend)) \
+        { \
+            dest[flamey_written++] = (*compare)(&second[flamey_j], &first[flamey_i]) < 0 ? second[flamey_j++] : first[flamey_i++]; \
+        } \
+        \
+        while (flamey_i <= (size_t) (firstend)) dest[flamey_written++] = first[flamey_i++]; \
+        while (flamey_j <= (size_t) (secondend)) dest[flamey_written++] = second[flamey_j++]; \
+    } \
+    \
+    flamey_written; \
+})
+
+/**
+    * @brief Writes the elements that are in `first`, in `second`, or in both, in order.
+    *           An element that is in both is written once (the one from `first`), so if neither array has duplicates, the result doesn't either.
+    *
+    * @param dest The destination array (at least as long as both ranges together).
+    * @param first The first sorted array.
+    * @param firststart The array index to start reading `first` from (`0` to start from the beginning).
+    * @param firstend The array index to stop reading `first` at (array length - 1 to finish at the end).
+    * @param second The second sorted array.
+    * @param secondstart The array index to start reading `second` from (`0` to start from the beginning).
+    * @param secondend The array index to stop reading `second` at (array length - 1 to finish at the end).
+    * @param compare The comparison function the arrays are sorted with.
+    *
+    * @return The number of elements written to `dest`.
+*/
+#define set_union(dest, first, firststart, firstend, second, secondstart, secondend, compare) ( \
+{ \
+    size_t flamey_written = 0; \
+    \
+    if (arrcheck(first, firststart, firstend, "set_union") && arrcheck(second, secondstart, secondend, "set_union")) \
+    { \
+        size_t flamey_i = firststart, flamey_j = secondstart; \
+        \
+        while (flamey_i <= (size_t) (firstend) && flamey_j <= (size_t) (secondend)) \
+        { \
+            int flamey_order = (*compare)(&first[flamey_i], &second[flamey_j]); \
+            \
+            if (flamey_order > 0) dest[flamey_written++] = second[flamey_j++]; \
+            else \
+            { \
+                if (flamey_order == 0) flamey_j++; \
+                dest[flamey_written++] = first[flamey_i++]; \
+            } \
+        } \
+        \
+        while (flamey_i <= (size_t) (firstend)) dest[flamey_written++] = first[flamey_i++]; \
+        while (flamey_j <= (size_t) (secondend)) dest[flamey_written++] = second[flamey_j++]; \
+    } \
+    \
+    flamey_written; \
+})
+
+/**
+    * @brief Finds the first element at or after `from` that doesn't go before `key`, by galloping: checks `from`, `from + 1`, `from + 3`, `from + 7`, ...,
+    *           then does a Binary Search in the last gap. Fast when the element is close to `from`.
+    *
+    *        ### The average user should not use this: use `set_intersection()` instead.
+    *
+    * @return The index of the element, or `end + 1` if every element goes before `key`.
+*/
+#define flamey_gallop(array, from, end, key, compare) ( \
+{ \
+    size_t flamey_low = (from), flamey_step = 1, flamey_high = (size_t) (end) + 1; \
+    \
+    while (flamey_low < flamey_high && (*compare)(&array[flamey_low], key) < 0) \
+    { \
+        size_t flamey_next = flamey_high - flamey_low > flamey_step ? flamey_low + flamey_step : flamey_high; \
+        \
+        if (flamey_next < flamey_high && (*compare)(&array[flamey_next], key) < 0) \
+        { \
+            flamey_low = flamey_next + 1; \
+            flamey_step *= 2; \
+        } \
+        else \
+        { \
+            flamey_low++; \
+            flamey_high = flamey_next; \
+            \
+            while (flamey_low < flamey_high) \
+            { \
+                size_t flamey_middle = flamey_low + (flamey_high - flamey_low) / 2; \
+                \
+                if ((*compare)(&array[flamey_middle], key) < 0) flamey_low = flamey_middle + 1; \
+                else flamey_high = flamey_middle; \
+            } \
+        } \
+    } \
+    \
+    flamey_low; \
+})
+
+/**
+    * @brief Writes the elements of `first` that are also in `second`, in order.
+    *           If one array is a lot shorter than the other, the longer one is searched by galloping instead of being read entirely.
+    *           Arrays of 32-bit integers sorted with `ascending()`, `int_ascending()` or `uint_ascending()` are compared 4 by 4 with SSE2.
+    *
+    * @param dest The destination array (at least as long as the range of `first`).
+    * @param first The first sorted array.
+    * @param firststart The array index to start reading `first` from (`0` to start from the beginning).
+    * @param firstend The array index to stop reading `first` at (array length - 1 to finish at the end).
+    * @param second The second sorted array.
+    * @param secondstart The array index to start reading `second` from (`0` to start from the beginning).
+    * @param secondend The array index to stop reading `second` at (array length - 1 to finish at the end).
+    * @param compare The comparison function the arrays are sorted with.
+    *
+    * @return The number of elements written to `dest`.
+*/
+#define set_intersection(dest, first, firststart, firstend, second, secondstart, secondend, compare) ( \
+{ \
+    size_t flamey_written = 0; \
+    \
+    if (arrcheck(first, firststart, firstend, "set_intersection") && arrcheck(second, secondstart, secondend, "set_intersection")) \
+    { \
+        size_t flamey_i = firststart, flamey_j = secondstart; \
+        size_t flamey_firstcount = (firstend) - (firststart) + 1, flamey_secondcount = (secondend) - (secondstart) + 1; \
+        \
+        if (flamey_firstcount * 32 < flamey_secondcount) \
+        { \
+            for (; flamey_i <= (size_t) (firstend) && flamey_j <= (size_t) (secondend); flamey_i++) \
+            { \
+                flamey_j = flamey_gallop(second, flamey_j, secondend, &first[flamey_i], compare); \
+                \
+                if (flamey_j <= (size_t) (secondend) && (*compare)(&second[flamey_j], &first[flamey_i]) == 0) dest[flamey_written++] = first[flamey_i]; \
+            } \
+        } \
+        else if (flamey_secondcount * 32 < flamey_firstcount) \
+        { \
+            for (; flamey_i <= (size_t) (firstend) && flamey_j <= (size_t) (secondend); flamey_j++) \
+            { \
+                flamey_i = flamey_gallop(first, flamey_i, firstend, &second[flamey_j], compare); \
+                \
+                while (flamey_i <= (size_t) (firstend) && (*compare)(&first[flamey_i], &second[flamey_j]) == 0) dest[flamey_written++] = first[flamey_i++]; \
+            } \
+        } \
+        else \
+        { \
+            flamey_intersect4(dest, flamey_written, first, flamey_i, firstend, second, flamey_j, secondend, compare); \
+            \
+            while (flamey_i <= (size_t) (firstend) && flamey_j <= (size_t) (secondend)) \
+            { \
+                int flamey_order = (*compare)(&first[flamey_i], &second[flamey_j]); \
+                \
+                if (flamey_order < 0) flamey_i++; \
+                else if (flamey_order > 0) flamey_j++; \
+                else dest[flamey_written++] = first[flamey_i++]; \
+            } \
+        } \
+    } \
+    \
+    flamey_written; \
+})
+
+/**
+    * @brief Compares blocks of 4 elements of `first` with blocks of 4 elements of `second` (all 4 rotations at once), if the arrays hold 32-bit integers
+    *           sorted in ascending order and SSE2 is available. The matches of a block of `first` are only written once it's done with,
+    *           so that duplicates spread over two blocks of `second` don't write it twice. Moves `flamey_i` and `flamey_j` to where the scalar loop should go on.
+    *
+    *        ### The average user should not use this: use `set_intersection()` instead.
+*/
+#if defined(__SSE2__)
+#define flamey_intersect4(dest, flamey_written, first, flamey_i, firstend, second, flamey_j, secondend, compare) ( \
+{ \
+    if (sizeof(first[0]) == 4 && sizeof(second[0]) == 4 && flamey_isinteger(typeof(first[0])) && flamey_isinteger(typeof(second[0])) && \
+        ((void (*)(void)) (compare) == (void (*)(void)) ascending || (void (*)(void)) (compare) == (void (*)(void)) int_ascending || \
+         (void (*)(void)) (compare) == (void (*)(void)) uint_ascending)) \
+    { \
+        size_t flamey_blockstart = flamey_j; \
+        int flamey_found = 0; \
+        \
+        while ((size_t) (firstend) - flamey_i >= 3 && flamey_i <= (size_t) (firstend) && (size_t) (secondend) - flamey_j >= 3 && flamey_j <= (size_t) (secondend)) \
+        { \
+            __m128i flamey_a = _mm_loadu_si128((const __m128i*) &first[flamey_i]); \
+            __m128i flamey_b = _mm_loadu_si128((const __m128i*) &second[flamey_j]); \
+            __m128i flamey_equal = _mm_or_si128( \
+                _mm_or_si128(_mm_cmpeq_epi32(flamey_a, flamey_b), _mm_cmpeq_epi32(flamey_a, _mm_shuffle_epi32(flamey_b, _MM_SHUFFLE(0, 3, 2, 1)))), \
+                _mm_or_si128(_mm_cmpeq_epi32(flamey_a, _mm_shuffle_epi32(flamey_b, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(flamey_a, _mm_shuffle_epi32(flamey_b, _MM_SHUFFLE(2, 1, 0, 3))))); \
+            \
+            flamey_found |= _mm_movemask_ps(_mm_castsi128_ps(flamey_equal)); \
+            \
+            if (second[flamey_j + 3] < first[flamey_i + 3]) flamey_j += 4; \
+            else \
+            { \
+                for (int flamey_lane = 0; flamey_lane < 4; flamey_lane++) \
+                { \
+                    if (flamey_found & (1 << flamey_lane)) dest[flamey_written++] = first[flamey_i + flamey_lane]; \
+                } \
+                \
+                flamey_found = 0; \
+                flamey_blockstart = flamey_j; \
+                flamey_i += 4; \
+            } \
+        } \
+        \
+        flamey_j = flamey_blockstart; \
+    } \
+})
+#else
+#define flamey_intersect4(dest, flamey_written, first, flamey_i, firstend, second, flamey_j, secondend, compare) ((void) 0)
+#endif
+
+/**
+    * @brief Writes the elements of `first` that are not in `second`, in order.
+    *
+    * @param dest The destination array (at least as long as the range of `first`).
+    * @param first The first sorted array.
+    * @param firststart The array index to start reading `first` from (`0` to start from the beginning).
+    * @param firstend The array index to stop reading `first` at (array length - 1 to finish at the end).
+    * @param second The second sorted array.
+    * @param secondstart The array index to start reading `second` from (`0` to start from the beginning).
+    * @param secondend The array index to stop reading `second` at (array length - 1 to finish at the end).
+    * @param compare The comparison function the arrays are sorted with.
+    *
+    * @return The number of elements written to `dest`.
+*/
+#define set_difference(dest, first, firststart, firstend, second, secondstart, secondend, compare) ( \
+{ \
+    size_t flamey_written = 0; \
+    \
+    if (arrcheck(first, firststart, firstend, "set_difference") && arrcheck(second, secondstart, secondend, "set_difference")) \
+    { \
+        size_t flamey_i = firststart, flamey_j = secondstart; \
+        \
+        while (flamey_i <= (size_t) (firstend) && flamey_j <= (size_t) (secondend)) \
+        { \
+            int flamey_order = (*compare)(&first[flamey_i], &second[flamey_j]); \
+            \
+            if (flamey_order < 0) dest[flamey_written++] = first[flamey_i++]; \
+            else if (flamey_order > 0) flamey_j++; \
+            else flamey_i++; \
+        } \
+        \
+        while (flamey_i <= (size_t) (firstend)) dest[flamey_written++] = first[flamey_i++]; \
+    } \
+    \
+    flamey_written; \
+})
+
+/**
+    * @brief Removes the duplicates of a sorted array, in place: the first of each group of equal elements is moved forward, keeping the order.
+    *
+    *        Example:
+    *```c
+    *int array[] = { 1, 1, 2, 3, 3, 3, 5 };
+    *size_t end = unique(array, 0, 6, ascending);   // array starts with { 1, 2, 3, 5 }, end is 3
+    *```
+    *
+    * @param array The sorted array.
+    * @param start The array index to start from (`0` to start from the beginning).
+    * @param end The array index to stop at (array length - 1 to finish at the end).
+    * @param compare The comparison function the array is sorted with.
+    *
+    * @return The new `end`: the index of the last element that was kept.
+*/
+#define unique(array, start, end, compare) ( \
+{ \
+    size_t flamey_last = end; \
+    \
+    if (arrcheck(array, start, end, "unique")) \
+    { \
+        flamey_last = start; \
+        \
+        for (size_t flamey_i = (size_t) (start) + 1; flamey_i <= (size_t) (end); flamey_i++) \
+        { \
+            if ((*compare)(&array[flamey_last], &array[flamey_i]) != 0 && ++flamey_last != flamey_i) array[flamey_last] = array[flamey_i]; \
+        } \
+    } \
+    \
+    flamey_last; \
+})
+
+/**
+    * @brief Merges `count` sorted arrays into one sorted array, using a loser tree: each element costs about log2(`count`) comparisons.
+    *           Equal elements keep their order, and the ones from earlier arrays come first.
+    *
+    *        Example:
+    *```c
+    *int* runs[3] = { a, b, c };
+    *size_t starts[3] = { 0, 0, 0 }, ends[3] = { 9, 4, 19 };
+    *kmerge(dest, runs, starts, ends, 3, ascending);
+    *```
+    *
+    * @param dest The destination array (at least as long as all the ranges together).
+    * @param arrays An array of `count` pointers to the sorted arrays.
+    * @param starts An array of `count` indices to start reading each array from.
+    * @param ends An array of `count` indices to stop reading each array at.
+    * @param count The number of arrays.
+    * @param compare The comparison function the arrays are sorted with.
+    *
+    * @return The number of elements written to `dest`.
+*/
+#define kmerge(dest, arrays, starts, ends, count, compare) ( \
+{ \
+    size_t flamey_written = 0; \
+    size_t flamey_runs = count; \
+    size_t* flamey_tree = flamey_runs > 0 ? malloc(4 * flamey_runs * sizeof(size_t)) : nullptr; \
+    \
+    if (flamey_runs > 0 && flamey_tree == nullptr) \
+    { \
+        fprintf(stderr, "kmerge(): not enough memory to merge %zu arrays.\n", flamey_runs); \
+        exit(EXIT_FAILURE); \
+    } \
+    \
+    if (flamey_runs > 0) \
+    { \
+        size_t* flamey_next = flamey_tree + flamey_runs; \
+        size_t* flamey_winners = flamey_next + flamey_runs; \
+        bool flamey_valid = true; \
+        \
+        for (size_t flamey_run = 0; flamey_run < flamey_runs && flamey_valid; flamey_run++) \
+        { \
+            flamey_valid = arrcheck(arrays[flamey_run], starts[flamey_run], ends[flamey_run], "kmerge"); \
+            flamey_next[flamey_run] = starts[flamey_run]; \
+        } \
+        \
+        bool flamey_beats(size_t flamey_a, size_t flamey_b) \
+        { \
+            if (flamey_next[flamey_b] > (size_t) ends[flamey_b]) return true; \
+            if (flamey_next[flamey_a] > (size_t) ends[flamey_a]) return false; \
+            \
+            int flamey_order = (*compare)(&arrays[flamey_a][flamey_next[flamey_a]], &arrays[flamey_b][flamey_next[flamey_b]]); \
+            \
+            return flamey_order < 0 || (flamey_order == 0 && flamey_a < flamey_b); \
+        } \
+        \
+        if (flamey_valid) \
+        { \
+            for (size_t flamey_node = 2 * flamey_runs - 1; flamey_node >= flamey_runs; flamey_node--) \
+            { \
+                flamey_winners[flamey_node] = flamey_node - flamey_runs; \
+            } \
+            \
+            for (size_t flamey_node = flamey_runs - 1; flamey_node >= 1; flamey_node--) \
+            { \
+                size_t flamey_a = flamey_winners[2 * flamey_node], flamey_b = flamey_winners[2 * flamey_node + 1]; \
+                \
+                flamey_winners[flamey_node] = flamey_beats(flamey_a, flamey_b) ? flamey_a : flamey_b; \
+                flamey_tree[flamey_node] = flamey_winners[flamey_node] == flamey_a ? flamey_b : flamey_a; \
+            } \
+            \
+            flamey_tree[0] = flamey_runs == 1 ? 0 : flamey_winners[1]; \
+            \
+            while (flamey_next[flamey_tree[0]] <= (size_t) ends[flamey_tree[0]]) \
+            { \
+                size_t flamey_winner = flamey_tree[0]; \
+                \
+                dest[flamey_written++] = arrays[flamey_winner][flamey_next[flamey_winner]++]; \
+                \
+                for (size_t flamey_node = (flamey_winner + flamey_runs) / 2; flamey_node >= 1; flamey_node /= 2) \
+                { \
+                    if (flamey_beats(flamey_tree[flamey_node], flamey_winner)) \
+                    { \
+                        size_t flamey_loser = flamey_winner; \
+                        \
+                        flamey_winner = flamey_tree[flamey_node]; \
+                        flamey_tree[flamey_node] = flamey_loser; \
+                    } \
+                } \
+                \
+                flamey_tree[0] = flamey_winner; \
+            } \
+        } \
+        \
+        free(flamey_tree); \
+    } \
+    \
+    flamey_written; \
+})
+
+/*
+    SORT DIRECTION UTILITIES
+*/
+
+/**
+    * @brief Defines comparison functions for a type, or for a key taken from it. For every `name`, this defines:
+    *           `int name_ascending(const void* a, const void* b)`      Three-way comparison for sorting in ascending order.
+    *           `int name_descending(const void* a, const void* b)`     Three-way comparison for sorting in descending order.
+    *           `bool name_less(const type* a, const type* b)`          Whether `a` goes before `b` in ascending order.
+    *        They are `static inline`, branchless for numbers, and can't overflow, so the sorting macros can inline them.
+    *        They are already defined for every primitive type (`int_ascending()`, `uint_ascending()`, `double_ascending()`, ...) and for strings (`string_ascending()`).
+    *
+    *        Examples:
+    *```c
+    *FLAMEY_CMP_DEFINE(int16_t);                              // int16_t_ascending(), ...
+    *FLAMEY_CMP_DEFINE_NAMED(ushort, unsigned short);         // ushort_ascending(), ...
+    *FLAMEY_CMP_DEFINE_FIELD(by_age, struct person, age);     // by_age_ascending(), ...
+    *
+    *#define name_length(person) strlen((person)->name)
+    *FLAMEY_CMP_DEFINE_KEY(by_name_length, struct person, name_length);
+    *```
+    *
+    * @param name Prefix of the names of the functions.
+    * @param type The type of the array elements.
+    * @param field The field of `type` to compare (`FLAMEY_CMP_DEFINE_FIELD()`).
+    * @param key A function or macro that takes a `const type*` and returns the value to compare (`FLAMEY_CMP_DEFINE_KEY()`).
+*/
+#define FLAMEY_CMP_DEFINE_KEY(name, type, key) \
+    static inline bool name##_less(const type* a, const type* b) \
+    { \
+        return key(a) < key(b); \
+    } \
+    \
+    static inline int name##_ascending(const void* a, const void* b) \
+    { \
+        typeof(key((const type*) a)) first = key((const type*) a); \
+        typeof(key((const type*) b)) second = key((const type*) b); \
+        \
+        return (first > second) - (first < second); \
+    } \
+    \
+    static inline int name##_descending(const void* a, const void* b) \
+    { \
+        return name##_ascending(b, a); \
+    }
+
+#define flamey_cmpvalue(pointer) (*(pointer))
+#define FLAMEY_CMP_DEFINE_NAMED(name, type) FLAMEY_CMP_DEFINE_KEY(name, type, flamey_cmpvalue)
+#define FLAMEY_CMP_DEFINE(type) FLAMEY_CMP_DEFINE_NAMED(type, type)
+
+#define FLAMEY_CMP_DEFINE_FIELD(name, type, field) \
+    static inline bool name##_less(const type* a, const type* b) \
+    { \
+        return a->field < b->field; \
+    } \
+    \
+    static inline int name##_ascending(const void* a, const void* b) \
+    { \
+        return (((const type*) a)->field > ((const type*) b)->field) - (((const type*) a)->field < ((const type*) b)->field); \
+    } \
+    \
+    static inline int name##_descending(const void* a, const void* b) \
+    { \
+        return name##_ascending(b, a); \
+    }
+
+FLAMEY_CMP_DEFINE(char)
+FLAMEY_CMP_DEFINE_NAMED(schar, signed char)
+FLAMEY_CMP_DEFINE_NAMED(uchar, unsigned char)
+FLAMEY_CMP_DEFINE(short)
+FLAMEY_CMP_DEFINE_NAMED(ushort, unsigned short)
+FLAMEY_CMP_DEFINE(int)
+FLAMEY_CMP_DEFINE_NAMED(uint, unsigned int)
+FLAMEY_CMP_DEFINE(long)
+FLAMEY_CMP_DEFINE_NAMED(ulong, unsigned long)
+FLAMEY_CMP_DEFINE_NAMED(llong, long long)
+FLAMEY_CMP_DEFINE_NAMED(ullong, unsigned long long)
+FLAMEY_CMP_DEFINE(float)
+FLAMEY_CMP_DEFINE(double)
+FLAMEY_CMP_DEFINE_NAMED(ldouble, long double)
+FLAMEY_CMP_DEFINE(size_t)
+
+/**
+    * @brief Comparison functions for arrays of null-terminated strings (`char*`), in `strcmp()` order.
+*/
+static inline bool string_less(char* const* a, char* const* b)
+{
+    return strcmp(*a, *b) < 0;
+}
+
+static inline int string_ascending(const void* a, const void* b)
+{
+    int result = strcmp(*(char* const*) a, *(char* const*) b);
+
+    return (result > 0) - (result < 0);
+}
+
+static inline int string_descending(const void* a, const void* b)
+{
+    return string_ascending(b, a);
+}
+
+/**
+    * @brief Same as `string_ascending()`, `string_descending()` and `string_less()`, but letters are compared like `lowercase()` would make them.
+*/
+static inline int string_nocase_ascending(const void* a, const void* b)
+{
+    const unsigned char* first = *(const unsigned char* const*) a;
+    const unsigned char* second = *(const unsigned char* const*) b;
+
+    while (*first != '\0' && tolower(*first) == tolower(*second))
+    {
+        first++;
+        second++;
+    }
+
+    int difference = tolower(*first) - tolower(*second);
+
+    return (difference > 0) - (difference < 0);
+}
+
+static inline int string_nocase_descending(const void* a, const void* b)
+{
+    return string_nocase_ascending(b, a);
+}
+
+static inline bool string_nocase_less(char* const* a, char* const* b)
+{
+    return string_nocase_ascending(a, b) < 0;
+}
+
+/**
+    * @brief Comparison function for sorting an `int` array in ascending order. Same as `int_ascending()`.
+    *           For other types, use the functions made by `FLAMEY_CMP_DEFINE()`.
+    * 
+    * @param a The first element to compare.
+    * @param b The second element to compare.
+    * 
+    * @return `-1` if `a` goes before `b`, `1` if it goes after, `0` if they are equal.
+*/
+static inline int ascending
+(
+    const void* a,
+    const void* b
+)
+{
+    return int_ascending(a, b);
+}
+
+/**
+    * @brief Comparison function for sorting an `int` array in descending order. Same as `int_descending()`.
+    *           For other types, use the functions made by `FLAMEY_CMP_DEFINE()`.
+    * 
+    * @param a The first element to compare.
+    * @param b The second element to compare.
+    * 
+    * @return `-1` if `a` goes before `b`, `1` if it goes after, `0` if they are equal.
+*/
+static inline int descending
+(
+    const void* a,
+    const void* b
+)
+{
+    return int_descending(a, b);
+}
+
+/**
+    * @brief Checks if `compare` is one of the functions of this header that sort integers in ascending order, so that a faster sort can be used instead.
+*/
+#define flamey_isascending(compare) \
+    ((void (*)(void)) (compare) == (void (*)(void)) ascending || (void (*)(void)) (compare) == (void (*)(void)) int_ascending || \
+     (void (*)(void)) (compare) == (void (*)(void)) uint_ascending || (void (*)(void)) (compare) == (void (*)(void)) long_ascending || \
+     (void (*)(void)) (compare) == (void (*)(void)) ulong_ascending || (void (*)(void)) (compare) == (void (*)(void)) llong_ascending || \
+     (void (*)(void)) (compare) == (void (*)(void)) ullong_ascending || (void (*)(void)) (compare) == (void (*)(void)) size_t_ascending || \
+     (void (*)(void)) (compare) == (void (*)(void)) short_ascending || (void (*)(void)) (compare) == (void (*)(void)) ushort_ascending || \
+     (void (*)(void)) (compare) == (void (*)(void)) char_ascending || (void (*)(void)) (compare) == (void (*)(void)) schar_ascending || \
+     (void (*)(void)) (compare) == (void (*)(void)) uchar_ascending)
+
+/*
+    SORTED CONTAINERS
+*/
+
+/**
+    * @brief Maximum number of elements in a block of a sorted container, divided by 2. Can be defined before including this header.
+*/
+#ifndef FLAMEY_SORTED_BLOCK
+#define FLAMEY_SORTED_BLOCK 512
+#endif
+
+/**
+    * @brief Defines a sorted container for a type: a list of sorted blocks of up to 2 * `FLAMEY_SORTED_BLOCK` elements, with the biggest element of each block
+    *           kept in its own array so that finding a block is a Binary Search on contiguous memory. Inserting or erasing only moves the elements of one block,
+    *           instead of sorting the whole array again. The same value can be inserted more than once. For every `name`, this defines:
+    *           `name`                                                          The container type.
+    *           `name_cursor`                                                   A position in the container, for going through a range of elements.
+    *           `void name_init(name* set)`                                     Makes an empty container.
+    *           `void name_free(name* set)`                                     Frees the memory of the container.
+    *           `size_t name_size(const name* set)`                             Gets the number of elements.
+    *           `void name_insert(name* set, type value)`                       Inserts an element.
+    *           `bool name_erase(name* set, type value)`                        Erases one element equal to `value`, if there is one.
+    *           `bool name_contains(const name* set, type value)`               Checks if an element is equal to `value`.
+    *           `size_t name_rank(const name* set, type value)`                 Gets the number of elements that go before `value`.
+    *           `const type* name_select(const name* set, size_t rank)`         Gets the element at a position in sorted order (`nullptr` if there isn't one).
+    *           `name_cursor name_lower(const name* set, type value)`           Gets the position of the first element that doesn't go before `value`.
+    *           `bool name_next(const name* set, name_cursor* at, type* value)` Puts the element at `at` in `value` and moves `at` forward (`false` at the end).
+    *           `size_t name_snapshot(const name* set, type* dest)`             Copies all the elements, sorted, to an array that the array macros can use.
+    *        They are `static inline`, so `compare` gets inlined.
+    *
+    *        Example:
+    *```c
+    *FLAMEY_SORTED_DEFINE(intset, int, int_ascending);
+    *
+    *intset set;
+    *intset_init(&set);
+    *intset_insert(&set, 42);
+    *intset_insert(&set, 7);
+    *
+    *int low = *intset_select(&set, 0);                // 7
+    *size_t below = intset_rank(&set, 10);              // 1
+    *
+    *int* sorted = malloc(intset_size(&set) * sizeof(int));
+    *intset_snapshot(&set, sorted);
+    *printarr(sorted, "%d", 0, intset_size(&set) - 1); // [7, 42]
+    *```
+    *
+    * @param name Name of the container type, and prefix of the names of the functions.
+    * @param type The type of the elements.
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define FLAMEY_SORTED_DEFINE(name, type, compare) \
+    typedef struct name \
+    { \
+        type** blocks; \
+        type* maxima; \
+        size_t* sizes; \
+        size_t* tree; \
+        size_t blockcount; \
+        size_t capacity; \
+        size_t size; \
+    } name; \
+    \
+    typedef struct name##_cursor \
+    { \
+        size_t block; \
+        size_t index; \
+    } name##_cursor; \
+    \
+    static inline void name##_init(name* set) \
+    { \
+        *set = (name) { nullptr, nullptr, nullptr, nullptr, 0, 0, 0 }; \
+    } \
+    \
+    static inline void name##_free(name* set) \
+    { \
+        for (size_t b = 0; b < set->blockcount; b++) free(set->blocks[b]); \
+        \
+        free(set->blocks); \
+        free(set->maxima); \
+        free(set->sizes); \
+        free(set->tree); \
+        name##_init(set); \
+    } \
+    \
+    static inline size_t name##_size(const name* set) \
+    { \
+        return set->size; \
+    } \
+    \
+    static inline void name##_rebuild(name* set) \
+    { \
+        for (size_t b = 1; b <= set->blockcount; b++) set->tree[b] = set->sizes[b - 1]; \
+        \
+        for (size_t b = 1; b <= set->blockcount; b++) \
+        { \
+            size_t parent = b + (b & -b); \
+            \
+            if (parent <= set->blockcount) set->tree[parent] += set->tree[b]; \
+        } \
+    } \
+    \
+    static inline void name##_count(name* set, size_t block, bool added) \
+    { \
+        for (size_t b = block + 1; b <= set->blockcount; b += b & -b) \
+        { \
+            if (added) set->tree[b]++; \
+            else set->tree[b]--; \
+        } \
+    } \
+    \
+    static inline size_t name##_before(const name* set, size_t block) \
+    { \
+        size_t count = 0; \
+        \
+        for (size_t b = block; b > 0; b -= b & -b) count += set->tree[b]; \
+        \
+        return count; \
+    } \
+    \
+    static inline size_t name##_findblock(const name* set, const type* value) \
+    { \
+        size_t low = 0, high = set->blockcount; \
+        \
+        while (low < high) \
+        { \
+            size_t middle = low + (high - low) / 2; \
+            \
+            if ((*compare)(&set->maxima[middle], value) < 0) low = middle + 1; \
+            else high = middle; \
+        } \
+        \
+        return low; \
+    } \
+    \
+    static inline size_t name##_findindex(const name* set, size_t block, const type* value) \
+    { \
+        size_t low = 0, high = set->sizes[block]; \
+        \
+        while (low < high) \
+        { \
+            size_t middle = low + (high - low) / 2; \
+            \
+            if ((*compare)(&set->blocks[block][middle], value) < 0) low = middle + 1; \
+            else high = middle; \
+        } \
+        \
+        return low; \
+    } \
+    \
+    static inline void name##_addblock(name* set, size_t at) \
+    { \
+        if (set->blockcount == set->capacity) \
+        { \
+            set->capacity = set->capacity ? 2 * set->capacity : 8; \
+            set->blocks = realloc(set->blocks, set->capacity * sizeof(type*)); \
+            set->maxima = realloc(set->maxima, set->capacity * sizeof(type)); \
+            set->sizes = realloc(set->sizes, set->capacity * sizeof(size_t)); \
+            set->tree = realloc(set->tree, (set->capacity + 1) * sizeof(size_t)); \
+            \
+            if (set->blocks == nullptr || set->maxima == nullptr || set->sizes == nullptr || set->tree == nullptr) \
+            { \
+                fprintf(stderr, #name "_insert(): not enough memory for %zu blocks.\n", set->capacity); \
+                exit(EXIT_FAILURE); \
+            } \
+        } \
+        \
+        memmove(&set->blocks[at + 1], &set->blocks[at], (set->blockcount - at) * sizeof(type*)); \
+        memmove(&set->maxima[at + 1], &set->maxima[at], (set->blockcount - at) * sizeof(type)); \
+        memmove(&set->sizes[at + 1], &set->sizes[at], (set->blockcount - at) * sizeof(size_t)); \
+        \
+        set->blocks[at] = malloc(2 * FLAMEY_SORTED_BLOCK * sizeof(type)); \
+        set->sizes[at] = 0; \
+        set->blockcount++; \
+        \
+        if (set->blocks[at] == nullptr) \
+        { \
+            fprintf(stderr, #name "_insert(): not enough memory for a new block.\n"); \
+            exit(EXIT_FAILURE); \
+        } \
+    } \
+    \
+    static inline void name##_removeblock(name* set, size_t at) \
+    { \
+        free(set->blocks[at]); \
+        set->blockcount--; \
+        \
+        memmove(&set->blocks[at], &set->blocks[at + 1], (set->blockcount - at) * sizeof(type*)); \
+        memmove(&set->maxima[at], &set->maxima[at + 1], (set->blockcount - at) * sizeof(type)); \
+        memmove(&set->sizes[at], &set->sizes[at + 1], (set->blockcount - at) * sizeof(size_t)); \
+    } \
+    \
+    static inline void name##_insert(name* set, type value) \
+    { \
+        if (set->blockcount == 0) name##_addblock(set, 0); \
+        \
+        size_t block = name##_findblock(set, &value); \
+        \
+        if (block == set->blockcount) block--; \
+        \
+        size_t index = name##_findindex(set, block, &value); \
+        type* items = set->blocks[block]; \
+        \
+        memmove(&items[index + 1], &items[index], (set->sizes[block] - index) * sizeof(type)); \
+        items[index] = value; \
+        set->maxima[block] = items[set->sizes[block]]; \
+        set->sizes[block]++; \
+        set->size++; \
+        \
+        if (set->sizes[block] < 2 * FLAMEY_SORTED_BLOCK) \
+        { \
+            if (set->blockcount == 1 && set->sizes[0] == 1) name##_rebuild(set); \
+            else name##_count(set, block, true); \
+            \
+            return; \
+        } \
+        \
+        name##_addblock(set, block + 1); \
+        memcpy(set->blocks[block + 1], &set->blocks[block][FLAMEY_SORTED_BLOCK], FLAMEY_SORTED_BLOCK * sizeof(type)); \
+        set->sizes[block] = FLAMEY_SORTED_BLOCK; \
+        set->sizes[block + 1] = FLAMEY_SORTED_BLOCK; \
+        set->maxima[block] = set->blocks[block][FLAMEY_SORTED_BLOCK - 1]; \
+        set->maxima[block + 1] = set->blocks[block + 1][FLAMEY_SORTED_BLOCK - 1]; \
+        name##_rebuild(set); \
+    } \
+    \
+    static inline bool name##_erase(name* set, type value) \
+    { \
+        size_t block = name##_findblock(set, &value); \
+        \
+        if (block == set->blockcount) return false; \
+        \
+        size_t index = name##_findindex(set, block, &value); \
+        type* items = set->blocks[block]; \
+        \
+        if ((*compare)(&items[index], &value) != 0) return false; \
+        \
+        set->sizes[block]--; \
+        set->size--; \
+        memmove(&items[index], &items[index + 1], (set->sizes[block] - index) * sizeof(type)); \
+        \
+        if (set->sizes[block] == 0) \
+        { \
+            name##_removeblock(set, block); \
+            name##_rebuild(set); \
+            \
+            return true; \
+        } \
+        \
+        set->maxima[block] = items[set->sizes[block] - 1]; \
+        \
+        if (block + 1 < set->blockcount && set->sizes[block] + set->sizes[block + 1] <= FLAMEY_SORTED_BLOCK) \
+        { \
+            memcpy(&items[set->sizes[block]], set->blocks[block + 1], set->sizes[block + 1] * sizeof(type)); \
+            set->sizes[block] += set->sizes[block + 1]; \
+            set->maxima[block] = set->maxima[block + 1]; \
+            name##_removeblock(set, block + 1); \
+            name##_rebuild(set); \
+        } \
+        else \
+        { \
+            name##_count(set, block, false); \
+        } \
+        \
+        return true; \
+    } \
+    \
+    static inline name##_cursor name##_lower(const name* set, type value) \
+    { \
+        size_t block = name##_findblock(set, &value); \
+        \
+        if (block == set->blockcount) return (name##_cursor) { block, 0 }; \
+        \
+        return (name##_cursor) { block, name##_findindex(set, block, &value) }; \
+    } \
+    \
+    static inline bool name##_contains(const name* set, type value) \
+    { \
+        name##_cursor at = name##_lower(set, value); \
+        \
+        return at.block < set->blockcount && (*compare)(&set->blocks[at.block][at.index], &value) == 0; \
+    } \
+    \
+    static inline size_t name##_rank(const name* set, type value) \
+    { \
+        name##_cursor at = name##_lower(set, value); \
+        \
+        return at.block < set->blockcount ? name##_before(set, at.block) + at.index : set->size; \
+    } \
+    \
+    static inline const type* name##_select(const name* set, size_t rank) \
+    { \
+        if (rank >= set->size) return nullptr; \
+        \
+        size_t block = 0; \
+        \
+        for (size_t step = (size_t) 1 << (63 - __builtin_clzll(set->blockcount)); step > 0; step /= 2) \
+        { \
+            if (block + step <= set->blockcount && set->tree[block + step] <= rank) \
+            { \
+                block += step; \
+                rank -= set->tree[block]; \
+            } \
+        } \
+        \
+        return &set->blocks[block][rank]; \
+    } \
+    \
+    static inline bool name##_next(const name* set, name##_cursor* at, type* value) \
+    { \
+        if (at->block < set->blockcount && at->index == set->sizes[at->block]) \
+        { \
+            at->block++; \
+            at->index = 0; \
+        } \
+        \
+        if (at->block >= set->blockcount) return false; \
+        \
+        *value = set->blocks[at->block][at->index++]; \
+        \
+        return true; \
+    } \
+    \
+    static inline size_t name##_snapshot(const name* set, type* dest) \
+    { \
+        size_t written = 0; \
+        \
+        for (size_t b = 0; b < set->blockcount; b++) \
+        { \
+            memcpy(&dest[written], set->blocks[b], set->sizes[b] * sizeof(type)); \
+            written += set->sizes[b]; \
+        } \
+        \
+        return written; \
+    }
+
+/*
+    STATISTICS VIEWS
+*/
+
+/**
+    * @brief Checks that [`start`, `end`] is a valid range of a statistics view, at the level chosen by `FLAMEY_CHECKS`.
+    *
+    *        ### The average user should not use this: use the functions made by `FLAMEY_STATVIEW_DEFINE()` instead.
+    *
+    * @param view The statistics view.
+    * @param start The index given as the start.
+    * @param end The index given as the end.
+    * @param funcname The calling function's name.
+    *
+    * @return `true` if the caller can go on, `false` if it should do nothing.
+*/
+#if FLAMEY_RUNTIME_CHECKS
+#define flamey_viewcheck(view, start, end, funcname) \
+    (arrcheck((view)->data, start, end, funcname) && __builtin_expect((end) < (view)->length || validarrfail(FLAMEY_EBOUNDS, (view)->length, end, funcname) == FLAMEY_OK, 1))
+#else
+#define flamey_viewcheck(view, start, end, funcname) (staticarrcheck(start, end), true)
+#endif
+
+/**
+    * @brief Defines a statistics view for a type: a growable array that keeps the sum, minimum and maximum of every range of it cached in a segment tree.
+    *           Changing, appending or removing the last element updates the cache in O(log n), and then the sum, average, minimum and maximum
+    *           of any range (and the indices of the minimum and maximum) are found in O(log n) too, instead of scanning the range again.
+    *           Sums are kept as `long double`, and recomputed from the elements instead of adjusted, so they don't drift after many changes.
+    *           For every `name`, this defines:
+    *           `name`                                                                  The view type. `data` points to the elements.
+    *           `void name_init(name* view)`                                            Makes an empty view.
+    *           `void name_assign(name* view, const type* array, size_t start, size_t end)` Replaces the elements with a copy of an array's, in O(n).
+    *           `void name_free(name* view)`                                            Frees the memory of the view.
+    *           `size_t name_length(const name* view)`                                  Gets the number of elements.
+    *           `type name_get(const name* view, size_t index)`                         Gets an element.
+    *           `void name_set(name* view, size_t index, type value)`                   Changes an element.
+    *           `void name_append(name* view, type value)`                              Adds an element at the end.
+    *           `void name_remove(name* view, size_t index)`                            Removes an element, moving the next ones back (O(log n) for the last one).
+    *           `long double name_sum(const name* view, size_t start, size_t end)`      Gets the sum of a range.
+    *           `long double name_average(const name* view, size_t start, size_t end)`  Gets the average of a range.
+    *           `type name_min(const name* view, size_t start, size_t end)`             Gets the minimum of a range.
+    *           `type name_max(const name* view, size_t start, size_t end)`             Gets the maximum of a range.
+    *           `size_t name_imin(const name* view, size_t start, size_t end)`          Gets the index of the minimum of a range (the first one, like `imin()`).
+    *           `size_t name_imax(const name* view, size_t start, size_t end)`          Gets the index of the maximum of a range (the first one, like `imax()`).
+    *        They are `static inline`. `data` can be read directly, but must only be changed with `name_set()`, or the cache gets out of date.
+    *
+    *        Example:
+    *```c
+    *FLAMEY_STATVIEW_DEFINE(intview, int);
+    *
+    *intview view;
+    *intview_init(&view);
+    *intview_assign(&view, array, 0, 999);
+    *
+    *intview_set(&view, 500, -7);
+    *intview_append(&view, 42);
+    *
+    *long double avg = intview_average(&view, 100, 899);
+    *size_t lowest = intview_imin(&view, 0, intview_length(&view) - 1);
+    *```
+    *
+    * @param name Name of the view type, and prefix of the names of the functions.
+    * @param type The type of the elements. It must be a number type.
+*/
+#define FLAMEY_STATVIEW_DEFINE(name, type) \
+    typedef struct name \
+    { \
+        type* data; \
+        long double* sums; \
+        size_t* mins; \
+        size_t* maxs; \
+        size_t length; \
+        size_t leaves; \
+    } name; \
+    \
+    static inline void name##_init(name* view) \
+    { \
+        *view = (name) { nullptr, nullptr, nullptr, nullptr, 0, 0 }; \
+    } \
+    \
+    static inline void name##_free(name* view) \
+    { \
+        free(view->data); \
+        free(view->sums); \
+        free(view->mins); \
+        free(view->maxs); \
+        name##_init(view); \
+    } \
+    \
+    static inline size_t name##_length(const name* view) \
+    { \
+        return view->length; \
+    } \
+    \
+    static inline size_t name##_pick(const name* view, size_t left, size_t right, bool maximum) \
+    { \
+        if (left == npos) return right; \
+        if (right == npos) return left; \
+        \
+        if (maximum) return view->data[right] > view->data[left] ? right : left; \
+        \
+        return view->data[right] < view->data[left] ? right : left; \
+    } \
+    \
+    static inline void name##_refresh(name* view, size_t first, size_t last) \
+    { \
+        for (size_t i = first; i <= last; i++) \
+        { \
+            size_t leaf = view->leaves + i; \
+            \
+            view->sums[leaf] = i < view->length ? (long double) view->data[i] : 0; \
+            view->mins[leaf] = view->maxs[leaf] = i < view->length ? i : npos; \
+        } \
+        \
+        for (size_t low = (view->leaves + first) >> 1, high = (view->leaves + last) >> 1; low > 0; low >>= 1, high >>= 1) \
+        { \
+            for (size_t node = low; node <= high; node++) \
+            { \
+                view->sums[node] = view->sums[2 * node] + view->sums[2 * node + 1]; \
+                view->mins[node] = name##_pick(view, view->mins[2 * node], view->mins[2 * node + 1], false); \
+                view->maxs[node] = name##_pick(view, view->maxs[2 * node], view->maxs[2 * node + 1], true); \
+            } \
+        } \
+    } \
+    \
+    static inline void name##_reserve(name* view, size_t length, const char* funcname) \
+    { \
+        if (length <= view->leaves) return; \
+        \
+        size_t leaves = view->leaves ? view->leaves : 16; \
+        \
+        while (leaves < length) leaves *= 2; \
+        \
+        view->data = realloc(view->data, leaves * sizeof(type)); \
+        view->sums = realloc(view->sums, 2 * leaves * sizeof(long double)); \
+        view->mins = realloc(view->mins, 2 * leaves * sizeof(size_t)); \
+        view->maxs = realloc(view->maxs, 2 * leaves * sizeof(size_t)); \
+        \
+        if (view->data == nullptr || view->sums == nullptr || view->mins == nullptr || view->maxs == nullptr) \
+        { \
+            fprintf(stderr, "%s(): not enough memory for %zu elements.\n", funcname, leaves); \
+            exit(EXIT_FAILURE); \
+        } \
+        \
+        view->leaves = leaves; \
+    } \
+    \
+    static inline void name##_assign(name* view, const type* array, size_t start, size_t end) \
+    { \
+        if (!arrcheck(array, start, end, #name "_assign")) return; \
+        \
+        name##_reserve(view, end + 1 - start, #name "_assign"); \
+        memcpy(view->data, &array[start], (end + 1 - start) * sizeof(type)); \
+        view->length = end + 1 - start; \
+        name##_refresh(view, 0, view->leaves - 1); \
+    } \
+    \
+    static inline type name##_get(const name* view, size_t index) \
+    { \
+        if (!flamey_viewcheck(view, index, index, #name "_get")) return (type) 0; \
+        \
+        return view->data[index]; \
+    } \
+    \
+    static inline void name##_set(name* view, size_t index, type value) \
+    { \
+        if (!flamey_viewcheck(view, index, index, #name "_set")) return; \
+        \
+        view->data[index] = value; \
+        name##_refresh(view, index, index); \
+    } \
+    \
+    static inline void name##_append(name* view, type value) \
+    { \
+        if (view->length == view->leaves) \
+        { \
+            name##_reserve(view, view->length + 1, #name "_append"); \
+            view->data[view->length++] = value; \
+            name##_refresh(view, 0, view->leaves - 1); \
+            return; \
+        } \
+        \
+        view->data[view->length++] = value; \
+        name##_refresh(view, view->length - 1, view->length - 1); \
+    } \
+    \
+    static inline void name##_remove(name* view, size_t index) \
+    { \
+        if (!flamey_viewcheck(view, index, index, #name "_remove")) return; \
+        \
+        memmove(&view->data[index], &view->data[index + 1], (view->length - index - 1) * sizeof(type)); \
+        view->length--; \
+        name##_refresh(view, index, view->length); \
+    } \
+    \
+    static inline long double name##_sum(const name* view, size_t start, size_t end) \
+    { \
+        if (!flamey_viewcheck(view, start, end, #name "_sum")) return 0; \
+        if (start == 0 && end == view->length - 1) return view->sums[1]; \
+        \
+        long double sum = 0; \
+        \
+        for (size_t low = view->leaves + start, high = view->leaves + end + 1; low < high; low >>= 1, high >>= 1) \
+        { \
+            if (low & 1) sum += view->sums[low++]; \
+            if (high & 1) sum += view->sums[--high]; \
+        } \
+        \
+        return sum; \
+    } \
+    \
+    static inline long double name##_average(const name* view, size_t start, size_t end) \
+    { \
+        if (!flamey_viewcheck(view, start, end, #name "_average")) return 0; \
+        \
+        return name##_sum(view, start, end) / (end + 1 - start); \
+    } \
+    \
+    static inline size_t name##_find(const name* view, size_t start, size_t end, bool maximum) \
+    { \
+        const size_t* nodes = maximum ? view->maxs : view->mins; \
+        \
+        if (start == 0 && end == view->length - 1) return nodes[1]; \
+        \
+        size_t left = npos, right = npos; \
+        \
+        for (size_t low = view->leaves + start, high = view->leaves + end + 1; low < high; low >>= 1, high >>= 1) \
+        { \
+            if (low & 1) left = name##_pick(view, left, nodes[low++], maximum); \
+            if (high & 1) right = name##_pick(view, nodes[--high], right, maximum); \
+        } \
+        \
+        return name##_pick(view, left, right, maximum); \
+    } \
+    \
+    static inline size_t name##_imin(const name* view, size_t start, size_t end) \
+    { \
+        if (!flamey_viewcheck(view, start, end, #name "_imin")) return start; \
+        \
+        return name##_find(view, start, end, false); \
+    } \
+    \
+    static inline size_t name##_imax(const name* view, size_t start, size_t end) \
+    { \
+        if (!flamey_viewcheck(view, start, end, #name "_imax")) return start; \
+        \
+        return name##_find(view, start, end, true); \
+    } \
+    \
+    static inline type name##_min(const name* view, size_t start, size_t end) \
+    { \
+        if (!flamey_viewcheck(view, start, end, #name "_min")) return (type) 0; \
+        \
+        return view->data[name##_find(view, start, end, false)]; \
+    } \
+    \
+    static inline type name##_max(const name* view, size_t start, size_t end) \
+    { \
+        if (!flamey_viewcheck(view, start, end, #name "_max")) return (type) 0; \
+        \
+        return view->data[name##_find(view, start, end, true)]; \
+    }
+
+/*
+    FIXED-SIZE ARRAY FUNCTIONS
+*/
+
+/*
+    These take a length `n` that is known at compile time instead of an `end`, so that the loops are fully unrolled and the indices are checked
+    with `_Static_assert()` instead of at runtime. They are meant for small, fixed ranges, like a 4, 8 or 16-element vector.
+*/
+
+/**
+    * @brief Biggest `n` that the fixed-size macros accept (`16` for `sort_n()`). Can be defined before including this header.
+*/
+#ifndef FLAMEY_UNROLL_MAX
+#define FLAMEY_UNROLL_MAX 64
+#endif
+
+/**
+    * @brief Checks at compile time that `n` is a constant between 1 and `limit`, and, if `array` is an array (and not a pointer) and `start` is
+    *           known at compile time, that [`start`, `start + n - 1`] is inside it.
+    *
+    *        ### The average user should not use this: it's used by `min_n()`, `sum_n()`, `sort_n()` and `copy_n()`.
+*/
+#define staticarrcheck_n(array, start, n, limit) \
+    ((void) sizeof(struct { \
+        _Static_assert(flamey_isconstexpr(n), "`n` must be known at compile time."); \
+        _Static_assert(__builtin_choose_expr(flamey_isconstexpr(n), (n) >= 1 && (n) <= (limit), 1), "`n` must be between 1 and `FLAMEY_UNROLL_MAX` (16 for `sort_n()`)."); \
+        _Static_assert(__builtin_choose_expr(flamey_isconstexpr((start) + (n)), (start) + (n) <= flamey_arrlen(array), 1), "`start + n - 1` must be an index of `array`."); \
+        int unused; }))
+
+/**
+    * @brief The type of `value`, without `const` or `volatile` (the result of the comma operator isn't an lvalue, so it loses them).
+*/
+#define flamey_unqual(value) typeof(((void) 0, (value)))
+
+/**
+    * @brief Comparators of the sorting networks used by `sort_n()`, for 2 to 16 elements, one after the other.
+    *           Up to 8 elements they are the smallest known networks; after that, they are Batcher's odd-even merge sort networks.
+    *
+    *        ### The average user should not use this: use `sort_n()` instead.
+*/
+static const unsigned char flamey_network[][2] __attribute__((unused)) =
+{
+    /* 2 elements */
+    { 0, 1 },
+    /* 3 elements */
+    { 0, 2 }, { 0, 1 }, { 1, 2 },
+    /* 4 elements */
+    { 0, 2 }, { 1, 3 }, { 0, 1 }, { 2, 3 }, { 1, 2 },
+    /* 5 elements */
+    { 0, 3 }, { 1, 4 }, { 0, 2 }, { 1, 3 }, { 0, 1 }, { 2, 4 }, { 1, 2 }, { 3, 4 }, { 2, 3 },
+    /* 6 elements */
+    { 0, 5 }, { 1, 3 }, { 2, 4 }, { 1, 2 }, { 3, 4 }, { 0, 3 }, { 2, 5 }, { 0, 1 }, { 2, 3 }, { 4, 5 },
+    { 1, 2 }, { 3, 4 },
+    /* 7 elements */
+    { 0, 6 }, { 2, 3 }, { 4, 5 }, { 0, 2 }, { 1, 4 }, { 3, 6 }, { 0, 1 }, { 2, 5 }, { 3, 4 }, { 1, 2 },
+    { 4, 6 }, { 2, 3 }, { 4, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+    /* 8 elements */
+    { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 0, 1 }, { 2, 3 },
+    { 4, 5 }, { 6, 7 }, { 2, 4 }, { 3, 5 }, { 1, 4 }, { 3, 6 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+    /* 9 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 }, { 1, 2 }, { 5, 6 },
+    { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 2, 4 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 0, 8 },
+    { 4, 8 }, { 2, 4 }, { 3, 5 }, { 6, 8 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 },
+    /* 10 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 }, { 1, 2 },
+    { 5, 6 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 2, 4 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+    { 0, 8 }, { 1, 9 }, { 4, 8 }, { 5, 9 }, { 2, 4 }, { 3, 5 }, { 6, 8 }, { 7, 9 }, { 1, 2 }, { 3, 4 },
+    { 5, 6 }, { 7, 8 },
+    /* 11 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 }, { 8, 10 },
+    { 1, 2 }, { 5, 6 }, { 9, 10 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 2, 4 }, { 3, 5 }, { 1, 2 },
+    { 3, 4 }, { 5, 6 }, { 9, 10 }, { 0, 8 }, { 1, 9 }, { 2, 10 }, { 4, 8 }, { 5, 9 }, { 6, 10 }, { 2, 4 },
+    { 3, 5 }, { 6, 8 }, { 7, 9 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 },
+    /* 12 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 10, 11 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+    { 8, 10 }, { 9, 11 }, { 1, 2 }, { 5, 6 }, { 9, 10 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 2, 4 },
+    { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 9, 10 }, { 0, 8 }, { 1, 9 }, { 2, 10 }, { 3, 11 }, { 4, 8 },
+    { 5, 9 }, { 6, 10 }, { 7, 11 }, { 2, 4 }, { 3, 5 }, { 6, 8 }, { 7, 9 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+    { 7, 8 }, { 9, 10 },
+    /* 13 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 10, 11 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+    { 8, 10 }, { 9, 11 }, { 1, 2 }, { 5, 6 }, { 9, 10 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 8, 12 },
+    { 2, 4 }, { 3, 5 }, { 10, 12 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 9, 10 }, { 11, 12 }, { 0, 8 }, { 1, 9 },
+    { 2, 10 }, { 3, 11 }, { 4, 12 }, { 4, 8 }, { 5, 9 }, { 6, 10 }, { 7, 11 }, { 2, 4 }, { 3, 5 }, { 6, 8 },
+    { 7, 9 }, { 10, 12 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+    /* 14 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 10, 11 }, { 12, 13 }, { 0, 2 }, { 1, 3 }, { 4, 6 },
+    { 5, 7 }, { 8, 10 }, { 9, 11 }, { 1, 2 }, { 5, 6 }, { 9, 10 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+    { 8, 12 }, { 9, 13 }, { 2, 4 }, { 3, 5 }, { 10, 12 }, { 11, 13 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 9, 10 },
+    { 11, 12 }, { 0, 8 }, { 1, 9 }, { 2, 10 }, { 3, 11 }, { 4, 12 }, { 5, 13 }, { 4, 8 }, { 5, 9 }, { 6, 10 },
+    { 7, 11 }, { 2, 4 }, { 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 }, { 11, 13 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+    { 7, 8 }, { 9, 10 }, { 11, 12 },
+    /* 15 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 10, 11 }, { 12, 13 }, { 0, 2 }, { 1, 3 }, { 4, 6 },
+    { 5, 7 }, { 8, 10 }, { 9, 11 }, { 12, 14 }, { 1, 2 }, { 5, 6 }, { 9, 10 }, { 13, 14 }, { 0, 4 }, { 1, 5 },
+    { 2, 6 }, { 3, 7 }, { 8, 12 }, { 9, 13 }, { 10, 14 }, { 2, 4 }, { 3, 5 }, { 10, 12 }, { 11, 13 }, { 1, 2 },
+    { 3, 4 }, { 5, 6 }, { 9, 10 }, { 11, 12 }, { 13, 14 }, { 0, 8 }, { 1, 9 }, { 2, 10 }, { 3, 11 }, { 4, 12 },
+    { 5, 13 }, { 6, 14 }, { 4, 8 }, { 5, 9 }, { 6, 10 }, { 7, 11 }, { 2, 4 }, { 3, 5 }, { 6, 8 }, { 7, 9 },
+    { 10, 12 }, { 11, 13 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 }, { 13, 14 },
+    /* 16 elements */
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 10, 11 }, { 12, 13 }, { 14, 15 }, { 0, 2 }, { 1, 3 },
+    { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 }, { 12, 14 }, { 13, 15 }, { 1, 2 }, { 5, 6 }, { 9, 10 }, { 13, 14 },
+    { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, { 8, 12 }, { 9, 13 }, { 10, 14 }, { 11, 15 }, { 2, 4 }, { 3, 5 },
+    { 10, 12 }, { 11, 13 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 9, 10 }, { 11, 12 }, { 13, 14 }, { 0, 8 }, { 1, 9 },
+    { 2, 10 }, { 3, 11 }, { 4, 12 }, { 5, 13 }, { 6, 14 }, { 7, 15 }, { 4, 8 }, { 5, 9 }, { 6, 10 }, { 7, 11 },
+    { 2, 4 }, { 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 }, { 11, 13 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 },
+    { 9, 10 }, { 11, 12 }, { 13, 14 }
+};
+
+/**
+    * @brief Index in `flamey_network` of the first comparator of the network for `n` elements (the network ends at `flamey_networkstart[n + 1]`).
+    *
+    *        ### The average user should not use this: use `sort_n()` instead.
+*/
+static const unsigned short flamey_networkstart[18] __attribute__((unused)) = { 0, 0, 0, 1, 4, 9, 18, 30, 46, 65, 93, 125, 163, 205, 253, 306, 365, 428 };
+
+/**
+    * @brief Finds the minimum value in a fixed-size range of an array, comparing the values in pairs (so that the comparisons don't wait for each other).
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param n The number of values to scan. Must be known at compile time.
+    *
+    * @return The minimum of `array[start]` to `array[start + n - 1]`.
+*/
+#define min_n(array, start, n) ( \
+{ \
+    staticarrcheck_n(array, start, n, FLAMEY_UNROLL_MAX); \
+    \
+    flamey_unqual((array)[0]) flamey_values[n]; \
+    \
+    _Pragma("GCC unroll 64") \
+    for (size_t flamey_i = 0; flamey_i < (n); flamey_i++) flamey_values[flamey_i] = (array)[(start) + flamey_i]; \
+    \
+    _Pragma("GCC unroll 8") \
+    for (size_t flamey_width = (n); flamey_width > 1; flamey_width = (flamey_width + 1) / 2) \
+    { \
+        _Pragma("GCC unroll 32") \
+        for (size_t flamey_i = 0; flamey_i < flamey_width / 2; flamey_i++) \
+        { \
+            if (flamey_values[flamey_i + (flamey_width + 1) / 2] < flamey_values[flamey_i]) flamey_values[flamey_i] = flamey_values[flamey_i + (flamey_width + 1) / 2]; \
+        } \
+    } \
+    \
+    flamey_values[0]; \
+})
+
+/**
+    * @brief Adds up the values in a fixed-size range of an array, in pairs (so that the additions don't wait for each other).
+    *
+    * @param array The array to scan.
+    * @param start The array index to start scanning from (`0` to start from the beginning).
+    * @param n The number of values to add. Must be known at compile time.
+    *
+    * @return The sum of `array[start]` to `array[start + n - 1]`, with the type that adding them gives (`int` for a `char` array, for example).
+*/
+#define sum_n(array, start, n) ( \
+{ \
+    staticarrcheck_n(array, start, n, FLAMEY_UNROLL_MAX); \
+    \
+    typeof((array)[0] + 0) flamey_values[n]; \
+    \
+    _Pragma("GCC unroll 64") \
+    for (size_t flamey_i = 0; flamey_i < (n); flamey_i++) flamey_values[flamey_i] = (array)[(start) + flamey_i]; \
+    \
+    _Pragma("GCC unroll 8") \
+    for (size_t flamey_width = (n); flamey_width > 1; flamey_width = (flamey_width + 1) / 2) \
+    { \
+        _Pragma("GCC unroll 32") \
+        for (size_t flamey_i = 0; flamey_i < flamey_width / 2; flamey_i++) flamey_values[flamey_i] += flamey_values[flamey_i + (flamey_width + 1) / 2]; \
+    } \
+    \
+    flamey_values[0]; \
+})
+
+/**
+    * @brief Sorts a fixed-size range of an array with a sorting network: a fixed list of compare-and-swaps, with no loops or branches left after unrolling.
+    * 
+    * @param array The array to sort.
+    * @param start The array index to start sorting from (`0` to start from the beginning).
+    * @param n The number of values to sort, up to 16. Must be known at compile time.
+    * @param compare A comparison function. This header provides `ascending()`, `descending()` and `FLAMEY_CMP_DEFINE()`, but you can make your own.
+*/
+#define sort_n(array, start, n, compare) ( \
+{ \
+    staticarrcheck_n(array, start, n, 16); \
+    \
+    typeof((array)[0]) flamey_values[n]; \
+    \
+    _Pragma("GCC unroll 16") \
+    for (size_t flamey_i = 0; flamey_i < (n); flamey_i++) flamey_values[flamey_i] = (array)[(start) + flamey_i]; \
+    \
+    _Pragma("GCC unroll 64") \
+    for (size_t flamey_k = flamey_networkstart[n]; flamey_k < flamey_networkstart[(n) + 1]; flamey_k++) \
+    { \
+        typeof((array)[0]) flamey_first = flamey_values[flamey_network[flamey_k][0]], flamey_second = flamey_values[flamey_network[flamey_k][1]]; \
+        bool flamey_swap = (*compare)(&flamey_second, &flamey_first) < 0; \
+        \
+        flamey_values[flamey_network[flamey_k][0]] = flamey_swap ? flamey_second : flamey_first; \
+        flamey_values[flamey_network[flamey_k][1]] = flamey_swap ? flamey_first : flamey_second; \
+    } \
+    \
+    _Pragma("GCC unroll 16") \
+    for (size_t flamey_i = 0; flamey_i < (n); flamey_i++) (array)[(start) + flamey_i] = flamey_values[flamey_i]; \
+})
+
+/**
+    * @brief Copies a fixed-size range of an array to the beginning of another array (`dest[0] = orig[start]`, ..., `dest[n - 1] = orig[start + n - 1]`).
+    *           All the values are read before any is written, so the two ranges can overlap.
+    * 
+    * @param dest The destination array.
+    * @param orig The original array.
+    * @param start The array index to start copying from (`0` to start from the beginning).
+    * @param n The number of values to copy. Must be known at compile time.
+*/
+#define copy_n(dest, orig, start, n) ( \
+{ \
+    staticarrcheck_n(dest, 0, n, FLAMEY_UNROLL_MAX); \
+    staticarrcheck_n(orig, start, n, FLAMEY_UNROLL_MAX); \
+    \
+    flamey_unqual((orig)[0]) flamey_values[n]; \
+    \
+    _Pragma("GCC unroll 64") \
+    for (size_t flamey_i = 0; flamey_i < (n); flamey_i++) flamey_values[flamey_i] = (orig)[(start) + flamey_i]; \
+    \
+    _Pragma("GCC unroll 64") \
+    for (size_t flamey_i = 0; flamey_i < (n); flamey_i++) (dest)[flamey_i] = flamey_values[flamey_i]; \
+})
+
+/*
+    COMPRESSED ARRAYS
+*/
+
+/*
+    `intpack()` stores an `int` array in blocks of 128 values. Each block is stored in the smallest of:
+        Frame of reference      The values minus the block's minimum, with as many bits as the biggest one needs.
+        Delta                   For blocks in ascending order: the difference between each value and the one 4 places before it, with as many bits as the biggest one needs.
+        Varint                  The values minus the block's minimum, in 1 to 5 bytes each (only when a few big values would make the other two waste space).
+    The bits are packed 4 values at a time, so that they are packed and unpacked with vector instructions.
+    Each block also keeps its minimum, maximum and sum, so `intpack_min()`, `intpack_max()` and `intpack_average()` only unpack the blocks at the edges of the range.
+    The format uses the byte order of the machine that packed it.
+*/
+
+/**
+    * @brief Gets the biggest number of bytes that `intpack()` can write for `count` values, to allocate its destination.
+    *
+    * @param count The number of values to pack.
+    *
+    * @return The number of bytes.
+*/
+FLAMEY_DEF size_t intpack_bound
+(
+    size_t count
+);
+
+/**
+    * @brief Packs an `int` array into a compressed array.
+    *
+    *        Example:
+    *```c
+    *void* packed = malloc(intpack_bound(1000));
+    *size_t bytes = intpack(array, 0, 999, packed);
+    *
+    *long double avg = intpack_average(packed, 0, 999);
+    *intunpack(packed, array);
+    *```
+    *
+    * @param array The array to pack.
+    * @param start The array index to start packing from (`0` to start from the beginning).
+    * @param end The array index to stop packing at (array length - 1 to finish at the end).
+    * @param dest Where to write the compressed array. Must have room for `intpack_bound(end - start + 1)` bytes.
+    *
+    * @return The number of bytes written.
+*/
+FLAMEY_DEF size_t intpack
+(
+    const int array[],
+    size_t start,
+    size_t end,
+    void* dest
+);
+
+/**
+    * @brief Gets the number of values in a compressed array.
+    *
+    * @param packed The compressed array.
+    *
+    * @return The number of values, or `0` if `packed` wasn't written by `intpack()`.
+*/
+FLAMEY_DEF size_t intpack_count
+(
+    const void* packed
+);
+
+/**
+    * @brief Unpacks a compressed array.
+    *
+    * @param packed The compressed array.
+    * @param dest The array to write the values to. Must have room for `intpack_count(packed)` values.
+    *
+    * @return The number of values written.
+*/
+FLAMEY_DEF size_t intunpack
+(
+    const void* packed,
+    int dest[]
+);
+
+/**
+    * @brief Finds the minimum value in a range of a compressed array, using the minimum of each block and only unpacking the blocks at the edges.
+    *
+    * @param packed The compressed array.
+    * @param start The index to start scanning from (`0` to start from the beginning).
+    * @param end The index to stop scanning at (`intpack_count(packed) - 1` to finish at the end).
+    *
+    * @return The minimum of the values in the range.
+*/
+FLAMEY_DEF int intpack_min
+(
+    const void* packed,
+    size_t start,
+    size_t end
+);
+
+/**
+    * @brief Finds the maximum value in a range of a compressed array, using the maximum of each block and only unpacking the blocks at the edges.
+    *
+    * @param packed The compressed array.
+    * @param start The index to start scanning from (`0` to start from the beginning).
+    * @param end The index to stop scanning at (`intpack_count(packed) - 1` to finish at the end).
+    *
+    * @return The maximum of the values in the range.
+*/
+FLAMEY_DEF int intpack_max
+(
+    const void* packed,
+    size_t start,
+    size_t end
+);
+
+/**
+    * @brief Calculates the average of a range of a compressed array, using the sum of each block and only unpacking the blocks at the edges.
+    *
+    * @param packed The compressed array.
+    * @param start The index to start scanning from (`0` to start from the beginning).
+    * @param end The index to stop scanning at (`intpack_count(packed) - 1` to finish at the end).
+    *
+    * @return The average of the values in the range.
+*/
+FLAMEY_DEF long double intpack_average
+(
+    const void* packed,
+    size_t start,
+    size_t end
+);
+
+/*
+    BITSETS
+*/
+
+/*
+    A bitset keeps one bit per element instead of the one byte of a `bool` array, in 64-bit words: it takes 8 times less memory,
+    and counting, searching and combining sets goes through 64 elements at a time. Bit `k` of a bitset made from a range of an array
+    is about element `start + k` of the array. `bitset_range()` compares 64 elements at a time a vector register at a time, then packs the results into bits
+    with SSE2's `movemask`, and `bitset_compress()` gathers the elements of the set bits, so a filter doesn't go through a `bool` array anymore.
+*/
+
+/**
+    * @brief Number of set bits in a word from which `bitset_compress()` copies every element of the word, instead of jumping from one set bit to the next.
+    *           Can be defined before including this header.
+*/
+#ifndef FLAMEY_BITSET_DENSE
+#define FLAMEY_BITSET_DENSE 16
+#endif
+
+/**
+    * @brief A packed array of bits. Bit `k` is bit `k % 64` of `words[k / 64]`, and the bits after `length` are always `0`.
+    *           Create it with `bitset_init()`, and free it with `bitset_free()`.
+*/
+typedef struct bitset
+{
+    uint64_t* words;
+    size_t length;
+} bitset;
+
+/**
+    * @brief Checks that `last` is a bit of a bitset, at the level chosen by `FLAMEY_CHECKS`.
+    *
+    *        ### The average user should not use this: it's used by the bitset functions.
+    *
+    * @param set The bitset.
+    * @param last The last bit index that will be used.
+    * @param funcname The calling function's name.
+    *
+    * @return `true` if the caller can go on, `false` if it should do nothing.
+*/
+static inline bool flamey_bitcheck
+(
+    const bitset* set,
+    size_t last,
+    const char* funcname
+)
+{
+    return !FLAMEY_RUNTIME_CHECKS || __builtin_expect(last < set->length, 1) || validarrfail(FLAMEY_EBOUNDS, set->length, last, funcname) == FLAMEY_OK;
+}
+
+/**
+    * @brief Packs 64 flags (bytes that are `0` or `1`, like `bool`s) into a 64-bit word, 16 at a time with SSE2. Used by `bitset_range()`.
+    *
+    *        ### The average user should not use this: use `bitset_range()` or `bitset_frombools()` instead.
+    *
+    * @param flags The 64 flags.
+    *
+    * @return The word, with bit `k` set if `flags[k]` is `1`.
+*/
+static inline uint64_t flamey_packflags
+(
+    const unsigned char flags[64]
+)
+{
+    uint64_t word = 0;
+
+#if defined(__SSE2__)
+    for (int k = 0; k < 4; k++)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i*) &flags[16 * k]);
+
+        word |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_slli_epi16(bytes, 7)) << (16 * k);
+    }
+#else
+    for (int k = 0; k < 64; k++) word |= (uint64_t) flags[k] << k;
+#endif
+
+    return word;
+}
+
+/**
+    * @brief Makes a bitset with all its bits set to `0`. Exits if there isn't enough memory.
+    *
+    * @param set The bitset to make.
+    * @param length The number of bits.
+*/
+FLAMEY_DEF void bitset_init
+(
+    bitset* set,
+    size_t length
+);
+
+/**
+    * @brief Frees the memory of a bitset, and leaves it with `0` bits.
+    *
+    * @param set The bitset to free.
+*/
+FLAMEY_DEF void bitset_free
+(
+    bitset* set
+);
+
+/**
+    * @brief Gets a bit of a bitset.
+    *
+    * @param set The bitset.
+    * @param index The index of the bit.
+    *
+    * @return `true` if the bit is set, `false` otherwise.
+*/
+static inline bool bitset_get
+(
+    const bitset* set,
+    size_t index
+)
+{
+    if (!flamey_bitcheck(set, index, "bitset_get")) return false;
+
+    return (set->words[index / 64] >> (index % 64)) & 1;
+}
+
+/**
+    * @brief Sets or clears a bit of a bitset.
+    *
+    * @param set The bitset.
+    * @param index The index of the bit.
+    * @param value `true` to set the bit, `false` to clear it.
+*/
+static inline void bitset_set
+(
+    bitset* set,
+    size_t index,
+    bool value
+)
+{
+    if (!flamey_bitcheck(set, index, "bitset_set")) return;
+
+    uint64_t bit = (uint64_t) 1 << (index % 64);
+
+    set->words[index / 64] = value ? set->words[index / 64] | bit : set->words[index / 64] & ~bit;
+}
+
+/**
+    * @brief Fills a bitset from a range of a `bool` array (bit `k` is `array[start + k]`), 16 `bool`s at a time with SSE2. The other bits are cleared.
+    *
+    * @param set The bitset to fill. Must have at least `end - start + 1` bits.
+    * @param array The `bool` array.
+    * @param start The array index to start reading from (`0` to start from the beginning).
+    * @param end The array index to stop reading at (array length - 1 to finish at the end).
+*/
+FLAMEY_DEF void bitset_frombools
+(
+    bitset* set,
+    const bool array[],
+    size_t start,
+    size_t end
+);
+
+/**
+    * @brief Fills a bitset with whether each element of a range of an array is between `low` and `high` (both included): bit `k` is set
+    *           if `low <= array[start + k] <= high`. The other bits are cleared. The elements are compared 64 at a time, and the results are packed
+    *           into a word with SSE2, so it's about as fast as filling a `bool` array, with 8 times less memory written.
+    *
+    *        Example:
+    *```c
+    *bitset cool;
+    *bitset_init(&cool, 1000);
+    *
+    *bitset_range(&cool, numbers, 0, 999, 10, 16);
+    *
+    *size_t howmany = bitset_count(&cool);
+    *int* coolnumbers = malloc(howmany * sizeof(int));
+    *bitset_compress(coolnumbers, numbers, 0, 999, &cool);
+    *
+    *bitset_free(&cool);
+    *```
+    *
+    * @param set The bitset to fill. Must have at least `end - start + 1` bits.
+    * @param array The array (or view) to compare.
+    * @param start The array index to start comparing from (`0` to start from the beginning).
+    * @param end The array index to stop comparing at (array length - 1 to finish at the end).
+    * @param low The lowest value that sets a bit.
+    * @param high The highest value that sets a bit.
+*/
+#define bitset_range(set, array, start, end, low, high) ( \
+{ \
+    bitset* flamey_bits = set; \
+    size_t flamey_start = start; \
+    size_t flamey_end = end; \
+    flamey_unqual(flamey_at(array, 0)) flamey_low = low; \
+    flamey_unqual(flamey_at(array, 0)) flamey_high = high; \
+    \
+    if (arrcheck(array, flamey_start, flamey_end, "bitset_range") && flamey_bitcheck(flamey_bits, flamey_end - flamey_start, "bitset_range")) \
+    { \
+        size_t flamey_count = flamey_end - flamey_start + 1; \
+        size_t flamey_word = 0; \
+        unsigned char flamey_flags[64]; \
+        \
+        for (; flamey_count - 64 * flamey_word >= 64; flamey_word++) \
+        { \
+            size_t flamey_first = flamey_start + 64 * flamey_word; \
+            \
+            for (size_t flamey_j = 0; flamey_j < 64; flamey_j++) \
+            { \
+                flamey_flags[flamey_j] = (flamey_at(array, flamey_first + flamey_j) >= flamey_low) & (flamey_at(array, flamey_first + flamey_j) <= flamey_high); \
+            } \
+            \
+            flamey_bits->words[flamey_word] = flamey_packflags(flamey_flags); \
+        } \
+        \
+        if (64 * flamey_word < flamey_count) \
+        { \
+            size_t flamey_first = flamey_start + 64 * flamey_word; \
+            \
+            memset(flamey_flags, 0, sizeof(flamey_flags)); \
+            \
+            for (size_t flamey_j = 0; flamey_j < flamey_count - 64 * flamey_word; flamey_j++) \
+            { \
+                flamey_flags[flamey_j] = (flamey_at(array, flamey_first + flamey_j) >= flamey_low) & (flamey_at(array, flamey_first + flamey_j) <= flamey_high); \
+            } \
+            \
+            flamey_bits->words[flamey_word++] = flamey_packflags(flamey_flags); \
+        } \
+        \
+        memset(&flamey_bits->words[flamey_word], 0, ((flamey_bits->length + 63) / 64 - flamey_word) * sizeof(uint64_t)); \
+    } \
+})
+
+/**
+    * @brief Counts the set bits of a bitset. Without the `popcnt` instruction, 2 words are counted at a time with vector instructions.
+    *
+    * @param set The bitset.
+    *
+    * @return The number of set bits.
+*/
+FLAMEY_DEF size_t bitset_count
+(
+    const bitset* set
+);
+
+/**
+    * @brief Counts the set bits before an index of a bitset.
+    *
+    * @param set The bitset.
+    * @param index The index to stop counting at (not included). Can be the length of the bitset, to count all of them.
+    *
+    * @return The number of set bits before `index`.
+*/
+FLAMEY_DEF size_t bitset_rank
+(
+    const bitset* set,
+    size_t index
+);
+
+/**
+    * @brief Finds the set bit that has `rank` set bits before it (the first one for `0`, ...). Skips 8 words at a time by counting their bits.
+    *
+    * @param set The bitset.
+    * @param rank The number of set bits before the one to find.
+    *
+    * @return The index of the bit, or `npos` if the bitset has `rank` set bits or less.
+*/
+FLAMEY_DEF size_t bitset_select
+(
+    const bitset* set,
+    size_t rank
+);
+
+/**
+    * @brief Keeps the bits set in both of two bitsets, a word at a time. `dest` can be `first` or `second`.
+    *
+    * @param dest The bitset to write to.
+    * @param first The first bitset. Must have at least as many bits as `dest`.
+    * @param second The second bitset. Must have at least as many bits as `dest`.
+*/
+FLAMEY_DEF void bitset_and
+(
+    bitset* dest,
+    const bitset* first,
+    const bitset* second
+);
+
+/**
+    * @brief Keeps the bits set in either of two bitsets, a word at a time. `dest` can be `first` or `second`.
+    *
+    * @param dest The bitset to write to.
+    * @param first The first bitset. Must have at least as many bits as `dest`.
+    * @param second The second bitset. Must have at least as many bits as `dest`.
+*/
+FLAMEY_DEF void bitset_or
+(
+    bitset* dest,
+    const bitset* first,
+    const bitset* second
+);
+
+/**
+    * @brief Keeps the bits set in only one of two bitsets, a word at a time. `dest` can be `first` or `second`.
+    *
+    * @param dest The bitset to write to.
+    * @param first The first bitset. Must have at least as many bits as `dest`.
+    * @param second The second bitset. Must have at least as many bits as `dest`.
+*/
+FLAMEY_DEF void bitset_xor
+(
+    bitset* dest,
+    const bitset* first,
+    const bitset* second
+);
+
+/**
+    * @brief Keeps the bits set in the first bitset but not in the second one, a word at a time. `dest` can be `first` or `second`.
+    *
+    * @param dest The bitset to write to.
+    * @param first The first bitset. Must have at least as many bits as `dest`.
+    * @param second The second bitset. Must have at least as many bits as `dest`.
+*/
+FLAMEY_DEF void bitset_andnot
+(
+    bitset* dest,
+    const bitset* first,
+    const bitset* second
+);
+
+/**
+    * @brief Flips every bit of a bitset, a word at a time. `dest` can be `set`.
+    *
+    * @param dest The bitset to write to.
+    * @param set The bitset to flip. Must have at least as many bits as `dest`.
+*/
+FLAMEY_DEF void bitset_not
+(
+    bitset* dest,
+    const bitset* set
+);
+
+/**
+    * @brief Copies the elements of a range of an array whose bit is set (`array[start + k]` if bit `k` is set) to `dest`, in order.
+    *           Words with every bit set are copied whole. Words with few set bits jump from one set bit to the next. Words with many set bits copy
+    *           every element up to the last set bit, and only move forward in `dest` for the selected ones, so there's no branch to mispredict.
+    *
+    * @param dest The array to copy to. Must have room for `bitset_count(set)` elements. Can be `&array[start]`, to filter an array in place.
+    * @param array The array (or view) to copy from.
+    * @param start The array index of bit `0` (`0` to start from the beginning).
+    * @param end The array index to stop copying at (array length - 1 to finish at the end).
+    * @param set The bitset that selects the elements. Must have at least `end - start + 1` bits.
+    *
+    * @return The number of elements copied.
+*/
+#define bitset_compress(dest, array, start, end, set) ( \
+{ \
+    const bitset* flamey_bits = set; \
+    size_t flamey_start = start; \
+    size_t flamey_end = end; \
+    size_t flamey_written = 0; \
+    \
+    if (arrcheck(array, flamey_start, flamey_end, "bitset_compress") && flamey_bitcheck(flamey_bits, flamey_end - flamey_start, "bitset_compress")) \
+    { \
+        size_t flamey_count = flamey_end - flamey_start + 1; \
+        \
+        for (size_t flamey_w = 0; 64 * flamey_w < flamey_count; flamey_w++) \
+        { \
+            uint64_t flamey_word = flamey_bits->words[flamey_w]; \
+            size_t flamey_first = flamey_start + 64 * flamey_w; \
+            \
+            if (flamey_count - 64 * flamey_w < 64) flamey_word &= ((uint64_t) 1 << (flamey_count - 64 * flamey_w)) - 1; \
+            \
+            if (flamey_word == UINT64_MAX) \
+            { \
+                for (size_t flamey_j = 0; flamey_j < 64; flamey_j++) (dest)[flamey_written + flamey_j] = flamey_at(array, flamey_first + flamey_j); \
+                \
+                flamey_written += 64; \
+            } \
+            else if (__builtin_popcountll(flamey_word) >= FLAMEY_BITSET_DENSE) \
+            { \
+                int flamey_last = 63 - __builtin_clzll(flamey_word); \
+                \
+                for (int flamey_j = 0; flamey_j <= flamey_last; flamey_j++) \
+                { \
+                    (dest)[flamey_written] = flamey_at(array, flamey_first + flamey_j); \
+                    flamey_written += (flamey_word >> flamey_j) & 1; \
+                } \
+            } \
+            else \
+            { \
+                for (; flamey_word != 0; flamey_word &= flamey_word - 1) \
+                { \
+                    (dest)[flamey_written++] = flamey_at(array, flamey_first + __builtin_ctzll(flamey_word)); \
+                } \
+            } \
+        } \
+    } \
+    \
+    flamey_written; \
+})
+
+/*
+    IMPLEMENTATION
+*/
+
+#ifdef FLAMEY_DEFINE_FUNCTIONS
+
+/*
+    MISCELLANEOUS UTILITIES
+*/
+
+FLAMEY_DATA _Thread_local int flamey_lasterror = FLAMEY_OK;
+
+FLAMEY_DEF void arghelper
+(
+    va_list* dest,
+    ...
+)
+{
+    va_list args;
+    va_start(args, dest);
+
+    va_copy(*dest, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF __attribute__((cold, noinline)) int validarrfail
+(
+    int error,
+    size_t start,
+    size_t end,
+    const char* funcname
+)
+{
+#ifdef FLAMEY_CHECKS_NOEXIT
+    (void) start;
+    (void) end;
+    (void) funcname;
+
+    flamey_lasterror = error;
+
+    return error;
+#else
+    if (error == FLAMEY_EBADRANGE)
+    {
+        fprintf(stderr, "%s(): `start` must be less than or equal to `end`.\nExpected `start` to be <= %zu, but it was %zu.\n", funcname, end, start);
+    }
+    else if (error == FLAMEY_EBOUNDS)
+    {
+        fprintf(stderr, "%s(): `end` must be less than the length.\nExpected `end` to be < %zu, but it was %zu.\n", funcname, start, end);
+    }
+    else
+    {
+        fprintf(stderr, "%s(): `array` cannot be a null pointer.\n", funcname);
+    }
+
+    exit(EXIT_FAILURE);
+#endif
+}
+
+/*
+    INSTRUMENTATION
+*/
+
+FLAMEY_DATA _Thread_local flamey_counters flamey_stats[FLAMEY_OPS] = { { 0 } };
+
+FLAMEY_DEF void flamey_dumpcounters(FILE* stream)
+{
+    const char* names[FLAMEY_OPS] = { "qsort", "bsort", "gsort", "is_sorted", "shuffle", "average", "min", "max", "med", "imin", "imax", "imed", "scan", "csort", "ksort", "argsort", "sort", "segsort" };
+
+    bool counted = false;
+
+    fprintf(stream, "%-10s %12s %12s %16s %16s %16s %16s\n", "macro", "calls", "checks", "comparisons", "swaps", "bytes moved", "ticks");
+
+    for (int op = 0; op < FLAMEY_OPS; op++)
+    {
+        flamey_counters* counters = &flamey_stats[op];
+
+        if (counters->calls == 0) continue;
+
+        fprintf(stream, "%-10s %12llu %12llu %16llu %16llu %16llu %16llu\n", names[op], counters->calls, counters->checks, counters->comparisons, counters->swaps, counters->bytes_moved, counters->ticks);
+        counted = true;
+    }
+
+    if (!counted)
+    {
+        fprintf(stream, "No macro calls were counted. Is `FLAMEY_INSTRUMENT` defined before including flameysutils.h?\n");
+    }
+}
+
+FLAMEY_DEF void flamey_resetcounters(void)
+{
+    memset(flamey_stats, 0, sizeof(flamey_stats));
+}
+
+/*
+    STRING UTILITIES
+*/
+
+FLAMEY_DEF void lowercase
+(
+    char* string,
+    size_t start,
+    size_t end
+)
+{
+    if (!arrcheck(string, start, end, "lowercase")) return;
+
+    for (size_t i = start; i <= end; i++)
+    {
+        string[i] = tolower(string[i]);
+    }
+}
+
+FLAMEY_DEF void uppercase
+(
+    char* string,
+    size_t start,
+    size_t end
+)
+{
+    if (!arrcheck(string, start, end, "uppercase")) return;
+
+    for (size_t i = start; i <= end; i++)
+    {
+        string[i] = toupper(string[i]);
+    }
+}
+
+FLAMEY_DEF size_t strfindchr
+(
+    const char* string,
+    size_t start,
+    size_t end,
+    char character
+)
+{
+    if (!arrcheck(string, start, end, "strfindchr")) return npos;
+
+    const char* found = memchr(string + start, character, end + 1 - start);
+
+    return found == nullptr ? npos : (size_t) (found - string);
+}
+
+FLAMEY_DEF size_t strfind
+(
+    const char* string,
+    size_t start,
+    size_t end,
+    const char* needle
+)
+{
+    if (!arrcheck(string, start, end, "strfind")) return npos;
+
+    size_t needlelen = strlen(needle);
+    size_t length = end + 1 - start;
+    const char* haystack = string + start;
+
+    if (needlelen == 0) return start;
+    if (needlelen > length) return npos;
+    if (needlelen == 1) return strfindchr(string, start, end, needle[0]);
+
+    size_t positions = length - needlelen + 1;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needlelen - 1]);
+
+    for (; i + 16 <= positions; i += 16)
+    {
+        __m128i blockfirst = _mm_loadu_si128((const __m128i*) (haystack + i));
+        __m128i blocklast = _mm_loadu_si128((const __m128i*) (haystack + i + needlelen - 1));
+        unsigned int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockfirst, first), _mm_cmpeq_epi8(blocklast, last)));
+
+        while (mask != 0)
+        {
+            unsigned int bit = __builtin_ctz(mask);
+
+            if (memcmp(haystack + i + bit + 1, needle + 1, needlelen - 2) == 0) return start + i + bit;
+
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < positions; i++)
+    {
+        if (haystack[i] == needle[0] && haystack[i + needlelen - 1] == needle[needlelen - 1] && memcmp(haystack + i + 1, needle + 1, needlelen - 2) == 0)
+        {
+            return start + i;
+        }
+    }
+
+    return npos;
+}
+
+FLAMEY_DEF size_t strfindany
+(
+    const char* string,
+    size_t start,
+    size_t end,
+    const char* characters
+)
+{
+    if (!arrcheck(string, start, end, "strfindany")) return npos;
+
+    size_t count = strlen(characters);
+    size_t i = start;
+
+    if (count == 0) return npos;
+    if (count == 1) return strfindchr(string, start, end, characters[0]);
+
+#if defined(__SSE2__)
+    if (count <= 16)
+    {
+        __m128i set[16];
+
+        for (size_t c = 0; c < count; c++)
+        {
+            set[c] = _mm_set1_epi8(characters[c]);
+        }
+
+        for (; i + 15 <= end; i += 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*) (string + i));
+            __m128i hits = _mm_cmpeq_epi8(block, set[0]);
+
+            for (size_t c = 1; c < count; c++)
+            {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, set[c]));
+            }
+
+            unsigned int mask = _mm_movemask_epi8(hits);
+
+            if (mask != 0) return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    bool table[256] = { false };
+
+    for (size_t c = 0; c < count; c++)
+    {
+        table[(unsigned char) characters[c]] = true;
+    }
+
+    for (; i <= end; i++)
+    {
+        if (table[(unsigned char) string[i]]) return i;
+    }
+
+    return npos;
+}
+
+FLAMEY_DEF void strsplit_init
+(
+    strsplit* iterator,
+    const char* string,
+    size_t start,
+    size_t end,
+    const char* delimiters,
+    bool skipempty
+)
+{
+    *iterator = (strsplit) { string, start, end, delimiters, skipempty, !arrcheck(string, start, end, "strsplit_init") };
+}
+
+FLAMEY_DEF bool strsplit_next
+(
+    strsplit* iterator,
+    strview* token
+)
+{
+    while (!iterator->done)
+    {
+        size_t position = iterator->position;
+        size_t found = position > iterator->end ? npos : strfindany(iterator->string, position, iterator->end, iterator->delimiters);
+
+        if (found == npos)
+        {
+            iterator->done = true;
+            *token = (strview) { iterator->string + position, iterator->end + 1 - position };
+        }
+        else
+        {
+            iterator->position = found + 1;
+            *token = (strview) { iterator->string + position, found - position };
+        }
+
+        if (!(iterator->skipempty && token->length == 0)) return true;
+    }
+
+    return false;
+}
+
+/*
+    INPUT FUNCTIONS
+*/
+
+FLAMEY_DEF void vinput
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    va_list args
+)
+{
+    vprintf(text, args);
+    fflush(stdin);
+    scanf(format, pointer);
+}
+
+FLAMEY_DEF void input
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    ...
+)
+{
+    va_list args;
+    va_start(args, pointer);
+
+    vinput(text, format, pointer, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void cvinput
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    const char* fail,
+    bool (*condition)(void*),
+    va_list args
+)
+{
+    va_list copy;
+    bool valid;
+
+    do
+    {
+        va_copy(copy, args);
+        vinput(text, format, pointer, copy);
+        va_end(copy);
+
+        valid = (*condition)(pointer);
+
+        if (!valid)
+        {
+            printf("%s", fail);
+        }
+    } while (!valid);
+}
+
+
+FLAMEY_DEF void cinput
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    const char* fail,
+    bool (*condition)(void*),
+    ...
+)
+{
+    va_list args;
+    va_start(args, condition);
+
+    cvinput(text, format, pointer, fail, condition, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void vcvinput
+(
+    const char* text,
+    const char* format,
+    void* pointer,
+    const char* fail,
+    bool (*condition)(void*, va_list),
+    va_list condargs,
+    va_list args
+)
+{
+    va_list argscopy, condargscopy;
+    bool valid;
+
+    do
+    {
+        va_copy(argscopy, args);
+        vinput(text, format, pointer, argscopy);
+        va_end(argscopy);
+
+        va_copy(condargscopy, condargs);
+        valid = (*condition)(pointer, condargscopy);
+        va_end(condargscopy);
+
+        if (!valid)
+        {
+            printf("%s", fail);
+        }
+    } while (!valid);
+}
+
+
+FLAMEY_DEF void vcinput
+(
+    const char* text,
+    const char* format, 
+    void* pointer,
+    const char* fail,
+    bool (*condition)(void*, va_list),
+    va_list condargs,
+    ...
+)
+{
+    va_list args;
+    va_start(args, condargs);
+
+    vcvinput(text, format, pointer, fail, condition, condargs, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void flamey_promptat
+(
+    const char* text,
+    const char* ordinal,
+    size_t index,
+    bool ordinalBefore,
+    va_list args
+)
+{
+    va_list copy;
+    va_copy(copy, args);
+
+    if (ordinalBefore)
+    {
+        printf(ordinal, index + 1);
+        vprintf(text, copy);
+    }
+    else
+    {
+        vprintf(text, copy);
+        printf(ordinal, index + 1);
+    }
+
+    va_end(copy);
+}
+
+FLAMEY_DEF void varrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    va_list args
+)
+{
+    if (!arrcheck(array, start, end, "varrinput")) return;
+
+    for (size_t i = start; i <= end; i++)
+    {
+        flamey_promptat(text, ordinal, i, ordinalBefore, args);
+
+        fflush(stdin);
+        scanf(format, (char*) array + (i * size));
+    }
+}
+
+
+FLAMEY_DEF void arrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    ...
+)
+{
+    va_list args;
+    va_start(args, ordinalBefore);
+
+    varrinput(text, ordinal, format, array, size, start, end, ordinalBefore, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void cvarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    bool (*condition)(void*),
+    va_list args
+)
+{
+    if (!arrcheck(array, start, end, "cvarrinput")) return;
+
+    for (size_t i = start; i <= end; i++)
+    {
+        void* element = (char*) array + (i * size);
+        bool valid;
+
+        do
+        {
+            flamey_promptat(text, ordinal, i, ordinalBefore, args);
+
+            fflush(stdin);
+            scanf(format, element);
+
+            valid = (*condition)(element);
+
+            if (!valid)
+            {
+                printf("%s", fail);
+            }
+        } while (!valid);
+    }
+}
+
+
+FLAMEY_DEF void carrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    bool (*condition)(void*),
+    ...
+)
+{
+    va_list args;
+    va_start(args, condition);
+
+    cvarrinput(text, ordinal, format, array, size, start, end, ordinalBefore, fail, condition, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void vcvarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    bool (*condition)(void*, va_list),
+    va_list condargs,
+    va_list args
+)
+{
+    if (!arrcheck(array, start, end, "vcvarrinput")) return;
+
+    va_list condargscopy;
+
+    for (size_t i = start; i <= end; i++)
+    {
+        void* element = (char*) array + (i * size);
+        bool valid;
+
+        do
+        {
+            flamey_promptat(text, ordinal, i, ordinalBefore, args);
+
+            fflush(stdin);
+            scanf(format, element);
+
+            va_copy(condargscopy, condargs);
+            valid = (*condition)(element, condargscopy);
+            va_end(condargscopy);
+
+            if (!valid)
+            {
+                printf("%s", fail);
+            }
+        } while (!valid);
+    }
+}
+
+
+FLAMEY_DEF void vcarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    bool (*condition)(void*, va_list),
+    va_list condargs,
+    ...
+)
+{
+    va_list args;
+    va_start(args, condargs);
+
+    vcvarrinput(text, ordinal, format, array, size, start, end, ordinalBefore, fail, condition, condargs, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void varrinputat
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    const size_t indices[],
+    size_t count,
+    bool ordinalBefore,
+    va_list args
+)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        flamey_promptat(text, ordinal, indices[i], ordinalBefore, args);
+
+        fflush(stdin);
+        scanf(format, (char*) array + (indices[i] * size));
+    }
+}
+
+FLAMEY_DEF void arrinputat
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    const size_t indices[],
+    size_t count,
+    bool ordinalBefore,
+    ...
+)
+{
+    va_list args;
+    va_start(args, ordinalBefore);
+
+    varrinputat(text, ordinal, format, array, size, indices, count, ordinalBefore, args);
+
+    va_end(args);
+}
+
+FLAMEY_DEF void bcvarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    void (*condition)(const void*, size_t, size_t, bool*),
+    va_list args
+)
+{
+    if (!arrcheck(array, start, end, "bcvarrinput")) return;
+
+    size_t count = end - start + 1;
+    bool* valid = malloc(count * sizeof(bool));
+    size_t* rejected = malloc(count * sizeof(size_t));
+    size_t rejections = 0;
+
+    if (valid == nullptr || rejected == nullptr)
+    {
+        fprintf(stderr, "bcvarrinput(): not enough memory to check %zu values.\n", count);
+        exit(EXIT_FAILURE);
+    }
+
+    varrinput(text, ordinal, format, array, size, start, end, ordinalBefore, args);
+
+    (*condition)(array, start, end, valid);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        rejected[rejections] = start + i;
+        rejections += !valid[i];
+    }
+
+    while (rejections > 0)
+    {
+        size_t remaining = 0;
+
+        printf("%s", fail);
+
+        varrinputat(text, ordinal, format, array, size, rejected, rejections, ordinalBefore, args);
+
+        for (size_t i = 0; i < rejections; i++)
+        {
+            (*condition)(array, rejected[i], rejected[i], valid);
+
+            rejected[remaining] = rejected[i];
+            remaining += !valid[0];
+        }
+
+        rejections = remaining;
+    }
+
+    free(valid);
+    free(rejected);
+}
+
+FLAMEY_DEF void bcarrinput
+(
+    const char* text,
+    const char* ordinal,
+    const char* format,
+    void* array,
+    size_t size,
+    size_t start,
+    size_t end,
+    bool ordinalBefore,
+    const char* fail,
+    void (*condition)(const void*, size_t, size_t, bool*),
+    ...
+)
+{
+    va_list args;
+    va_start(args, condition);
+
+    bcvarrinput(text, ordinal, format, array, size, start, end, ordinalBefore, fail, condition, args);
+
+    va_end(args);
+}
+
+/*
+    RANDOMIZATION FUNCTIONS
+*/
+
+FLAMEY_DEF void randints
+(
+    int array[],
+    size_t start,
+    size_t end,
+    int min,
+    int max
+)
+{
+    if (!arrcheck(array, start, end, "randints")) return;
+
+    srand(time(0));
+
+    for (size_t i = start; i <= end; i++)
+    {
+        array[i] = randint(min, max);
+    }
+}
+
+#define FLAMEY_RAND_BLOCK 256
+
+typedef uint64_t flamey_vec_rand __attribute__((vector_size(32)));
+
+typedef struct flamey_randreader
+{
+    randstate* state;
+    size_t next;
+    uint64_t buffer[FLAMEY_RAND_BLOCK];
+} flamey_randreader;
+
+FLAMEY_DATA uint32_t flamey_kn[128];
+FLAMEY_DATA double flamey_wn[128];
+FLAMEY_DATA double flamey_fn[128];
+FLAMEY_DATA uint32_t flamey_ke[256];
+FLAMEY_DATA double flamey_we[256];
+FLAMEY_DATA double flamey_fe[256];
+FLAMEY_DATA pthread_once_t flamey_zigguratonce = PTHREAD_ONCE_INIT;
+
+FLAMEY_DEF void randseed
+(
+    randstate* state,
+    uint64_t seed
+)
+{
+    for (size_t word = 0; word < 4; word++)
+    {
+        for (size_t lane = 0; lane < 4; lane++)
+        {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            state->s[word][lane] = z ^ (z >> 31);
+        }
+    }
+}
+
+FLAMEY_DEF void flamey_randblock
+(
+    randstate* state,
+    uint64_t* dest,
+    size_t count
+)
+{
+    flamey_vec_rand s0, s1, s2, s3;
+
+    memcpy(&s0, state->s[0], sizeof(s0));
+    memcpy(&s1, state->s[1], sizeof(s1));
+    memcpy(&s2, state->s[2], sizeof(s2));
+    memcpy(&s3, state->s[3], sizeof(s3));
+
+    for (size_t i = 0; i < count; i += 4)
+    {
+        flamey_vec_rand result = s1 * 5;
+        flamey_vec_rand t = s1 << 17;
+
+        result = ((result << 7) | (result >> 57)) * 9;
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = (s3 << 45) | (s3 >> 19);
+
+        memcpy(&dest[i], &result, sizeof(result));
+    }
+
+    memcpy(state->s[0], &s0, sizeof(s0));
+    memcpy(state->s[1], &s1, sizeof(s1));
+    memcpy(state->s[2], &s2, sizeof(s2));
+    memcpy(state->s[3], &s3, sizeof(s3));
+}
+
+static inline uint64_t flamey_randnext(flamey_randreader* reader)
+{
+    if (reader->next == FLAMEY_RAND_BLOCK)
+    {
+        flamey_randblock(reader->state, reader->buffer, FLAMEY_RAND_BLOCK);
+        reader->next = 0;
+    }
+
+    return reader->buffer[reader->next++];
+}
+
+static inline double flamey_randunit(uint64_t bits)
+{
+    double unit;
+
+    bits = (bits >> 12) | 0x3FF0000000000000ull;
+    memcpy(&unit, &bits, sizeof(unit));
+
+    return unit - 1.0;
+}
+
+static inline double flamey_randopen(flamey_randreader* reader)
+{
+    return 1.0 - flamey_randunit(flamey_randnext(reader));
+}
+
+FLAMEY_DEF void randfloats
+(
+    float array[],
+    size_t start,
+    size_t end,
+    float min,
+    float max,
+    randstate* state
+)
+{
+    if (!arrcheck(array, start, end, "randfloats")) return;
+
+    uint64_t buffer[FLAMEY_RAND_BLOCK];
+    float range = max - min;
+
+    for (size_t first = start; first <= end; first += FLAMEY_RAND_BLOCK)
+    {
+        size_t count = end - first + 1 < FLAMEY_RAND_BLOCK ? end - first + 1 : FLAMEY_RAND_BLOCK;
+
+        flamey_randblock(state, buffer, (count + 3) & ~(size_t) 3);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t bits = (uint32_t) (buffer[i] >> 41) | 0x3F800000u;
+            float unit;
+
+            memcpy(&unit, &bits, sizeof(unit));
+            array[first + i] = min + (unit - 1.0f) * range;
+        }
+
+        if (count < FLAMEY_RAND_BLOCK) break;
+    }
+}
+
+FLAMEY_DEF void randdoubles
+(
+    double array[],
+    size_t start,
+    size_t end,
+    double min,
+    double max,
+    randstate* state
+)
+{
+    if (!arrcheck(array, start, end, "randdoubles")) return;
+
+    uint64_t buffer[FLAMEY_RAND_BLOCK];
+    double range = max - min;
+
+    for (size_t first = start; first <= end; first += FLAMEY_RAND_BLOCK)
+    {
+        size_t count = end - first + 1 < FLAMEY_RAND_BLOCK ? end - first + 1 : FLAMEY_RAND_BLOCK;
+
+        flamey_randblock(state, buffer, (count + 3) & ~(size_t) 3);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            array[first + i] = min + flamey_randunit(buffer[i]) * range;
+        }
+
+        if (count < FLAMEY_RAND_BLOCK) break;
+    }
+}
+
+static inline void flamey_ziggurat(void)
+{
+    double dn = 3.442619855899, tn = dn, vn = 9.91256303526217e-3;
+    double q = vn / exp(-0.5 * dn * dn);
+
+    flamey_kn[0] = (uint32_t) (dn / q * 2147483648.0);
+    flamey_kn[1] = 0;
+    flamey_wn[0] = q / 2147483648.0;
+    flamey_wn[127] = dn / 2147483648.0;
+    flamey_fn[0] = 1.0;
+    flamey_fn[127] = exp(-0.5 * dn * dn);
+
+    for (size_t i = 126; i >= 1; i--)
+    {
+        dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+        flamey_kn[i + 1] = (uint32_t) (dn / tn * 2147483648.0);
+        tn = dn;
+        flamey_fn[i] = exp(-0.5 * dn * dn);
+        flamey_wn[i] = dn / 2147483648.0;
+    }
+
+    double de = 7.697117470131487, te = de, ve = 3.949659822581572e-3;
+
+    q = ve / exp(-de);
+    flamey_ke[0] = (uint32_t) (de / q * 4294967296.0);
+    flamey_ke[1] = 0;
+    flamey_we[0] = q / 4294967296.0;
+    flamey_we[255] = de / 4294967296.0;
+    flamey_fe[0] = 1.0;
+    flamey_fe[255] = exp(-de);
+
+    for (size_t i = 254; i >= 1; i--)
+    {
+        de = -log(ve / de + exp(-de));
+        flamey_ke[i + 1] = (uint32_t) (de / te * 4294967296.0);
+        te = de;
+        flamey_fe[i] = exp(-de);
+        flamey_we[i] = de / 4294967296.0;
+    }
+}
+
+static inline double flamey_randnormal(flamey_randreader* reader)
+{
+    for (;;)
+    {
+        uint64_t bits = flamey_randnext(reader);
+        int32_t hz = (int32_t) (bits >> 32);
+        size_t iz = bits & 127;
+        double x = hz * flamey_wn[iz];
+
+        if ((uint32_t) llabs(hz) < flamey_kn[iz]) return x;
+
+        if (iz == 0)
+        {
+            double y;
+
+            do
+            {
+                x = -log(flamey_randopen(reader)) / 3.442619855899;
+                y = -log(flamey_randopen(reader));
+            }
+            while (y + y < x * x);
+
+            return hz > 0 ? 3.442619855899 + x : -3.442619855899 - x;
+        }
+
+        if (flamey_fn[iz] + flamey_randunit(flamey_randnext(reader)) * (flamey_fn[iz - 1] - flamey_fn[iz]) < exp(-0.5 * x * x)) return x;
+    }
+}
+
+static inline double flamey_randexponential(flamey_randreader* reader)
+{
+    for (;;)
+    {
+        uint64_t bits = flamey_randnext(reader);
+        uint32_t jz = (uint32_t) (bits >> 32);
+        size_t iz = bits & 255;
+        double x = jz * flamey_we[iz];
+
+        if (jz < flamey_ke[iz]) return x;
+        if (iz == 0) return 7.697117470131487 - log(flamey_randopen(reader));
+
+        if (flamey_fe[iz] + flamey_randunit(flamey_randnext(reader)) * (flamey_fe[iz - 1] - flamey_fe[iz]) < exp(-x)) return x;
+    }
+}
+
+FLAMEY_MATHDEF void randnormals
+(
+    double array[],
+    size_t start,
+    size_t end,
+    double mean,
+    double stddev,
+    randstate* state
+)
+{
+    if (!arrcheck(array, start, end, "randnormals")) return;
+
+    pthread_once(&flamey_zigguratonce, flamey_ziggurat);
+
+    flamey_randreader reader = { state, FLAMEY_RAND_BLOCK, { 0 } };
+
+    for (size_t i = start; i <= end; i++)
+    {
+        array[i] = mean + stddev * flamey_randnormal(&reader);
+    }
+}
+
+FLAMEY_MATHDEF void randexponentials
+(
+    double array[],
+    size_t start,
+    size_t end,
+    double rate,
+    randstate* state
+)
+{
+    if (!arrcheck(array, start, end, "randexponentials")) return;
+
+    pthread_once(&flamey_zigguratonce, flamey_ziggurat);
+
+    flamey_randreader reader = { state, FLAMEY_RAND_BLOCK, { 0 } };
+
+    for (size_t i = start; i <= end; i++)
+    {
+        array[i] = flamey_randexponential(&reader) / rate;
+    }
+}
+
+static inline double flamey_zipfh(double x, double exponent)
+{
+    return exp(-exponent * log(x));
+}
+
+static inline double flamey_zipfintegral(double x, double exponent)
+{
+    double logx = log(x), t = (1.0 - exponent) * logx;
+
+    return (fabs(t) > 1e-8 ? expm1(t) / t : 1.0 + t * 0.5 * (1.0 + t / 3.0 * (1.0 + 0.25 * t))) * logx;
+}
+
+static inline double flamey_zipfinverse(double x, double exponent)
+{
+    double t = x * (1.0 - exponent);
+
+    if (t < -1.0) t = -1.0;
+
+    return exp((fabs(t) > 1e-8 ? log1p(t) / t : 1.0 - t * (0.5 - t * (1.0 / 3.0 - 0.25 * t))) * x);
+}
+
+FLAMEY_MATHDEF void randzipfs
+(
+    size_t array[],
+    size_t start,
+    size_t end,
+    size_t n,
+    double exponent,
+    randstate* state
+)
+{
+    if (!arrcheck(array, start, end, "randzipfs")) return;
+
+    flamey_randreader reader = { state, FLAMEY_RAND_BLOCK, { 0 } };
+    double low = flamey_zipfintegral(1.5, exponent) - 1.0;
+    double high = flamey_zipfintegral(n + 0.5, exponent);
+    double squeeze = 2.0 - flamey_zipfinverse(flamey_zipfintegral(2.5, exponent) - flamey_zipfh(2.0, exponent), exponent);
+
+    for (size_t i = start; i <= end; i++)
+    {
+        for (;;)
+        {
+            double u = high + flamey_randunit(flamey_randnext(&reader)) * (low - high);
+            double x = flamey_zipfinverse(u, exponent);
+            size_t k = x < 1.5 ? 1 : x >= n ? n : (size_t) (x + 0.5);
+
+            if (k - x <= squeeze || u >= flamey_zipfintegral(k + 0.5, exponent) - flamey_zipfh(k, exponent))
+            {
+                array[i] = k;
+                break;
+            }
+        }
+    }
+}
+
+/*
+    PARALLEL UTILITIES
+*/
+
+typedef struct flamey_job
+{
+    void (*function)(size_t, size_t, void*);
+    void* context;
+    size_t start;
+    size_t end;
+    size_t grain;
+    bool steal;
+    size_t next[FLAMEY_MAX_THREADS];
+    size_t limit[FLAMEY_MAX_THREADS];
+} flamey_job;
+
+typedef struct flamey_pool
+{
+    pthread_mutex_t busy;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned long long generation;
+    size_t threads;
+    size_t finished;
+    flamey_job* job;
+} flamey_pool;
+
+FLAMEY_DATA flamey_pool flamey_threadpool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, nullptr };
+FLAMEY_DATA pthread_once_t flamey_poolonce = PTHREAD_ONCE_INIT;
+FLAMEY_DATA _Thread_local bool flamey_inparallel = false;
+
+FLAMEY_DEF void flamey_runjob(flamey_job* job, size_t id)
+{
+    size_t participants = flamey_threadpool.threads;
+
+    for (size_t k = 0; k < participants; k++)
+    {
+        size_t victim = (id + k) % participants;
+
+        if (k > 0 && !job->steal) break;
+
+        while (true)
+        {
+            size_t chunk = __atomic_fetch_add(&job->next[victim], 1, __ATOMIC_RELAXED);
+
+            if (chunk >= job->limit[victim]) break;
+
+            size_t first = job->start + chunk * job->grain;
+            size_t last = job->end - first < job->grain ? job->end : first + job->grain - 1;
+
+            job->function(first, last, job->context);
+        }
+    }
+}
+
+FLAMEY_DEF void* flamey_worker(void* argument)
+{
+    size_t id = (size_t) argument;
+    unsigned long long seen = 0;
+
+    flamey_inparallel = true;
+
+    pthread_mutex_lock(&flamey_threadpool.lock);
+
+    while (true)
+    {
+        while (flamey_threadpool.generation == seen)
+        {
+            pthread_cond_wait(&flamey_threadpool.wake, &flamey_threadpool.lock);
+        }
+
+        seen = flamey_threadpool.generation;
+        flamey_job* job = flamey_threadpool.job;
+
+        pthread_mutex_unlock(&flamey_threadpool.lock);
+
+        flamey_runjob(job, id);
+
+        pthread_mutex_lock(&flamey_threadpool.lock);
+
+        if (++flamey_threadpool.finished == flamey_threadpool.threads - 1)
+        {
+            pthread_cond_signal(&flamey_threadpool.done);
+        }
+    }
+
+    return nullptr;
+}
+
+FLAMEY_DEF void flamey_startpool(void)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* wanted = getenv("FLAMEY_THREADS");
+
+    if (wanted != nullptr && atol(wanted) > 0) cpus = atol(wanted);
+    if (cpus < 1) cpus = 1;
+    if (cpus > FLAMEY_MAX_THREADS) cpus = FLAMEY_MAX_THREADS;
+
+    flamey_threadpool.threads = 1;
+
+    for (long id = 1; id < cpus; id++)
+    {
+        pthread_t thread;
+
+        if (pthread_create(&thread, nullptr, flamey_worker, (void*) id) != 0) break;
+
+        pthread_detach(thread);
+        flamey_threadpool.threads++;
+    }
+}
+
+FLAMEY_DEF size_t parallel_threads(void)
+{
+    pthread_once(&flamey_poolonce, flamey_startpool);
+
+    return flamey_threadpool.threads;
+}
+
+FLAMEY_DEF void flamey_parallel
+(
+    size_t start,
+    size_t end,
+    size_t grain,
+    bool steal,
+    void (*function)(size_t, size_t, void*),
+    void* context
+)
+{
+    size_t count = end - start + 1;
+
+    if (flamey_inparallel || count <= grain || parallel_threads() == 1)
+    {
+        function(start, end, context);
+        return;
+    }
+
+    flamey_job job = { function, context, start, end, grain, steal, { 0 }, { 0 } };
+    size_t participants = flamey_threadpool.threads;
+    size_t chunks = (count - 1) / grain + 1;
+
+    for (size_t id = 0; id < participants; id++)
+    {
+        job.next[id] = chunks * id / participants;
+        job.limit[id] = chunks * (id + 1) / participants;
+    }
+
+    pthread_mutex_lock(&flamey_threadpool.busy);
+    flamey_inparallel = true;
+
+    pthread_mutex_lock(&flamey_threadpool.lock);
+    flamey_threadpool.job = &job;
+    flamey_threadpool.finished = 0;
+    flamey_threadpool.generation++;
+    pthread_cond_broadcast(&flamey_threadpool.wake);
+    pthread_mutex_unlock(&flamey_threadpool.lock);
+
+    flamey_runjob(&job, 0);
+
+    pthread_mutex_lock(&flamey_threadpool.lock);
+
+    while (flamey_threadpool.finished < participants - 1)
+    {
+        pthread_cond_wait(&flamey_threadpool.done, &flamey_threadpool.lock);
+    }
+
+    pthread_mutex_unlock(&flamey_threadpool.lock);
+
+    flamey_inparallel = false;
+    pthread_mutex_unlock(&flamey_threadpool.busy);
+}
+
+FLAMEY_DEF void parallel_for
+(
+    size_t start,
+    size_t end,
+    size_t grain,
+    void (*function)(size_t, size_t, void*),
+    void* context
+)
+{
+    if (!arrcheck(function, start, end, "parallel_for")) return;
+
+    if (grain == 0)
+    {
+        grain = (end - start + 1) / (8 * parallel_threads());
+        if (grain == 0) grain = 1;
+    }
+
+    flamey_parallel(start, end, grain, true, function, context);
+}
+
+FLAMEY_DEF void parallel_for_static
+(
+    size_t start,
+    size_t end,
+    void (*function)(size_t, size_t, void*),
+    void* context
+)
+{
+    if (!arrcheck(function, start, end, "parallel_for_static")) return;
+
+    size_t grain = (end - start) / parallel_threads() + 1;
+
+    flamey_parallel(start, end, grain, false, function, context);
+}
+
+/*
+    ARRAY UTILITIES
+*/
+
+FLAMEY_DATA size_t flamey_llcsize = 0;
+
+FLAMEY_DEF size_t flamey_streamthreshold(void)
+{
+    if (FLAMEY_STREAM_COPY != 0) return FLAMEY_STREAM_COPY;
+
+    size_t size = __atomic_load_n(&flamey_llcsize, __ATOMIC_RELAXED);
+
+    if (size == 0)
+    {
+        long cache = -1;
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+        cache = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if (cache <= 0) cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+
+        size = cache > 0 ? (size_t) cache : 8388608;
+        __atomic_store_n(&flamey_llcsize, size, __ATOMIC_RELAXED);
+    }
+
+    return size;
+}
+
+FLAMEY_DEF void flamey_streamblock
+(
+    char* dest,
+    const char* orig,
+    size_t size
+)
+{
+#if defined(__SSE2__)
+    size_t head = (16 - ((uintptr_t) dest & 15)) & 15;
+
+    if (head > size) head = size;
+
+    memcpy(dest, orig, head);
+    dest += head;
+    orig += head;
+    size -= head;
+
+    for (; size >= 64; size -= 64, dest += 64, orig += 64)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*) orig);
+        __m128i b = _mm_loadu_si128((const __m128i*) (orig + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*) (orig + 32));
+        __m128i d = _mm_loadu_si128((const __m128i*) (orig + 48));
+
+        _mm_stream_si128((__m128i*) dest, a);
+        _mm_stream_si128((__m128i*) (dest + 16), b);
+        _mm_stream_si128((__m128i*) (dest + 32), c);
+        _mm_stream_si128((__m128i*) (dest + 48), d);
+    }
+
+    _mm_sfence();
+#endif
+
+    memcpy(dest, orig, size);
+}
+
+FLAMEY_DEF void flamey_streamchunk(size_t first, size_t last, void* data)
+{
+    char** areas = data;
+
+    flamey_streamblock(areas[0] + first, areas[1] + first, last - first + 1);
+}
+
+FLAMEY_DEF void* streamcopy
+(
+    void* dest,
+    const void* orig,
+    size_t size
+)
+{
+    char* to = dest;
+    const char* from = orig;
+
+    if (size < flamey_streamthreshold() || ((uintptr_t) to - (uintptr_t) from < size || (uintptr_t) from - (uintptr_t) to < size))
+    {
+        return memmove(dest, orig, size);
+    }
+
+    if (size >= FLAMEY_PARALLEL_COPY)
+    {
+        char* areas[2] = { to, (char*) from };
+
+        parallel_for(0, size - 1, 1048576, flamey_streamchunk, areas);
+    }
+    else
+    {
+        flamey_streamblock(to, from, size);
+    }
+
+    return dest;
+}
+
+/*
+    ARRAY SORTING FUNCTIONS
+*/
+
+FLAMEY_DATA void (*sorthook)(const char* algorithm, size_t count, size_t size) = nullptr;
+
+typedef struct flamey_strkey
+{
+    uint64_t key;
+    char* string;
+} flamey_strkey;
+
+typedef struct flamey_strtask
+{
+    size_t low;
+    size_t high;
+    size_t depth;
+} flamey_strtask;
+
+__attribute__((no_sanitize_address)) static inline uint64_t flamey_strload(const char* string, size_t depth, bool ignorecase)
+{
+    const unsigned char* bytes = (const unsigned char*) string + depth;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!ignorecase && ((uintptr_t) bytes & 4095) <= 4088)
+    {
+        uint64_t word;
+
+        memcpy(&word, bytes, sizeof(word));
+
+        uint64_t zeros = (word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull;
+
+        if (zeros != 0) word &= ((zeros & -zeros) >> 7) - 1;
+
+        return __builtin_bswap64(word);
+    }
+#endif
+
+    uint64_t key = 0;
+
+    for (size_t i = 0; i < 8; i++)
+    {
+        uint64_t byte = ignorecase ? (unsigned char) tolower(bytes[i]) : bytes[i];
+
+        key |= byte << (56 - 8 * i);
+
+        if (byte == 0) break;
+    }
+
+    return key;
+}
+
+static inline int flamey_strorder(const flamey_strkey* a, const flamey_strkey* b, size_t depth, bool ignorecase)
+{
+    if (a->key != b->key) return a->key < b->key ? -1 : 1;
+    if ((a->key & 0xFF) == 0) return 0;
+
+    const char* first = a->string + depth + 8;
+    const char* second = b->string + depth + 8;
+
+    return ignorecase ? string_nocase_ascending(&first, &second) : strcmp(first, second);
+}
+
+FLAMEY_DEF void strsort
+(
+    char* array[],
+    size_t start,
+    size_t end,
+    bool ignorecase
+)
+{
+    if (!arrcheck(array, start, end, "strsort")) return;
+
+    size_t count = end - start + 1, capacity = 64, pending = 0;
+    flamey_strkey* keys = malloc(count * sizeof(flamey_strkey));
+    flamey_strtask* tasks = malloc(capacity * sizeof(flamey_strtask));
+
+    if (keys == nullptr || tasks == nullptr)
+    {
+        free(keys);
+        free(tasks);
+
+        if (ignorecase) qsort(array, start, end, string_nocase_ascending);
+        else qsort(array, start, end, string_ascending);
+
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        keys[i] = (flamey_strkey) { flamey_strload(array[start + i], 0, ignorecase), array[start + i] };
+    }
+
+    tasks[pending++] = (flamey_strtask) { 0, count - 1, 0 };
+
+    while (pending > 0)
+    {
+        flamey_strtask task = tasks[--pending];
+        size_t low = task.low, high = task.high;
+
+        if (high - low < 16)
+        {
+            for (size_t i = low + 1; i <= high; i++)
+            {
+                flamey_strkey item = keys[i];
+                size_t j = i;
+
+                while (j > low && flamey_strorder(&item, &keys[j - 1], task.depth, ignorecase) < 0)
+                {
+                    keys[j] = keys[j - 1];
+                    j--;
+                }
+
+                keys[j] = item;
+            }
+
+            continue;
+        }
+
+        uint64_t a = keys[low].key, b = keys[low + (high - low) / 2].key, c = keys[high].key;
+        uint64_t pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+        size_t less = low, i = low, greater = high;
+
+        while (i <= greater)
+        {
+            if (keys[i].key < pivot) swap(&keys[less++], &keys[i++], sizeof(flamey_strkey));
+            else if (keys[i].key > pivot) swap(&keys[i], &keys[greater--], sizeof(flamey_strkey));
+            else i++;
+        }
+
+        if (pending + 3 > capacity)
+        {
+            capacity *= 2;
+            tasks = realloc(tasks, capacity * sizeof(flamey_strtask));
+
+            if (tasks == nullptr)
+            {
+                fprintf(stderr, "strsort(): not enough memory for %zu pending partitions.\n", capacity);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if (less > low) tasks[pending++] = (flamey_strtask) { low, less - 1, task.depth };
+        if (greater < high) tasks[pending++] = (flamey_strtask) { greater + 1, high, task.depth };
+
+        if ((pivot & 0xFF) != 0 && greater > less)
+        {
+            for (size_t k = less; k <= greater; k++) keys[k].key = flamey_strload(keys[k].string, task.depth + 8, ignorecase);
+
+            tasks[pending++] = (flamey_strtask) { less, greater, task.depth + 8 };
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) array[start + i] = keys[i].string;
+
+    free(keys);
+    free(tasks);
+}
+
+typedef struct flamey_gather
+{
+    const size_t* indices;
+    const char* from;
+    char* to;
+    size_t size;
+} flamey_gather;
+
+FLAMEY_DEF void flamey_gatherchunk(size_t first, size_t last, void* data)
+{
+    flamey_gather* gather = data;
+    const size_t* indices = gather->indices;
+    size_t size = gather->size;
+
+#define flamey_gatherloop(type) \
+    for (size_t k = first; k <= last; k++) \
+    { \
+        if (k + 16 <= last) __builtin_prefetch(gather->from + indices[k + 16] * sizeof(type)); \
+        memcpy(gather->to + k * sizeof(type), gather->from + indices[k] * sizeof(type), sizeof(type)); \
+    }
+
+    switch (size)
+    {
+        case 1: flamey_gatherloop(uint8_t); break;
+        case 2: flamey_gatherloop(uint16_t); break;
+        case 4: flamey_gatherloop(uint32_t); break;
+        case 8: flamey_gatherloop(uint64_t); break;
+        default:
+            for (size_t k = first; k <= last; k++)
+            {
+                if (k + 16 <= last) __builtin_prefetch(gather->from + indices[k + 16] * size);
+                memcpy(gather->to + k * size, gather->from + indices[k] * size, size);
+            }
+    }
+
+#undef flamey_gatherloop
+}
+
+FLAMEY_DEF void permute
+(
+    const size_t* indices,
+    size_t start,
+    size_t end,
+    void* array,
+    size_t size
+)
+{
+    if (!arrcheck(array, start, end, "permute")) return;
+
+    size_t count = end - start + 1;
+    char* items = array;
+    char* buffer = malloc(count * size);
+
+    if (buffer != nullptr)
+    {
+        flamey_gather gather = { indices, items, buffer, size };
+
+        parallel_for(0, count - 1, FLAMEY_GRAIN, flamey_gatherchunk, &gather);
+        streamcopy(items + start * size, buffer, count * size);
+        free(buffer);
+
+        return;
+    }
+
+    unsigned char* visited = calloc(count / 8 + 1, 1);
+    char* item = malloc(size);
+
+    if (visited == nullptr || item == nullptr)
+    {
+        fprintf(stderr, "permute(): not enough memory to reorder %zu elements.\n", count);
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t k = 0; k < count; k++)
+    {
+        if (visited[k / 8] & (1 << (k % 8))) continue;
+
+        memcpy(item, items + (start + k) * size, size);
+
+        size_t hole = k;
+
+        while (indices[hole] - start != k)
+        {
+            size_t next = indices[hole] - start;
+
+            memcpy(items + (start + hole) * size, items + (start + next) * size, size);
+            visited[hole / 8] |= 1 << (hole % 8);
+            hole = next;
+        }
+
+        memcpy(items + (start + hole) * size, item, size);
+        visited[hole / 8] |= 1 << (hole % 8);
+    }
+
+    free(visited);
+    free(item);
+}
+
+/*
+    COMPRESSED ARRAYS
+*/
+
+#define FLAMEY_PACK_BLOCK 128
+#define FLAMEY_PACK_MAGIC 0x4B504C46u
+
+enum flamey_packmode
+{
+    FLAMEY_PACK_FOR,
+    FLAMEY_PACK_DELTA,
+    FLAMEY_PACK_VARINT
+};
+
+typedef uint32_t flamey_vec_pack __attribute__((vector_size(16)));
+
+typedef struct flamey_packheader
+{
+    uint32_t magic;
+    uint32_t block;
+    uint64_t count;
+} flamey_packheader;
+
+typedef struct flamey_packblock
+{
+    uint8_t mode;
+    uint8_t bits;
+    uint16_t count;
+    int32_t min;
+    int32_t max;
+    uint32_t size;
+    int64_t sum;
+} flamey_packblock;
+
+static inline __attribute__((always_inline)) void flamey_packbits(const uint32_t* values, uint8_t* dest, unsigned bits)
+{
+    flamey_vec_pack packed = { 0 };
+    unsigned shift = 0;
+    size_t word = 0;
+
+    if (bits == 0) return;
+
+    _Pragma("GCC unroll 32")
+    for (size_t j = 0; j < FLAMEY_PACK_BLOCK / 4; j++)
+    {
+        flamey_vec_pack value;
+
+        memcpy(&value, &values[4 * j], sizeof(value));
+        packed |= value << shift;
+        shift += bits;
+
+        if (shift >= 32)
+        {
+            memcpy(&dest[sizeof(packed) * word++], &packed, sizeof(packed));
+            shift -= 32;
+            packed = shift > 0 ? value >> (bits - shift) : (flamey_vec_pack) { 0 };
+        }
+    }
+}
+
+static inline __attribute__((always_inline)) void flamey_unpackbits(const uint8_t* packed, uint32_t* dest, unsigned bits)
+{
+    if (bits == 0)
+    {
+        memset(dest, 0, FLAMEY_PACK_BLOCK * sizeof(uint32_t));
+        return;
+    }
+
+    flamey_vec_pack mask = (flamey_vec_pack) { 0 } + (bits == 32 ? 0xFFFFFFFFu : (1u << (bits & 31)) - 1);
+    flamey_vec_pack word;
+    unsigned shift = 0;
+    size_t next = 1;
+
+    memcpy(&word, packed, sizeof(word));
+
+    _Pragma("GCC unroll 32")
+    for (size_t j = 0; j < FLAMEY_PACK_BLOCK / 4; j++)
+    {
+        flamey_vec_pack value = word >> shift;
+
+        shift += bits;
+
+        if (shift >= 32)
+        {
+            shift -= 32;
+
+            if (next < bits) memcpy(&word, &packed[sizeof(word) * next++], sizeof(word));
+            if (shift > 0) value |= word << (bits - shift);
+        }
+
+        value &= mask;
+        memcpy(&dest[4 * j], &value, sizeof(value));
+    }
+}
+
+#define flamey_packcases(function, ...) \
+    switch (bits) \
+    { \
+        case 0: function(__VA_ARGS__, 0); break; case 1: function(__VA_ARGS__, 1); break; case 2: function(__VA_ARGS__, 2); break; \
+        case 3: function(__VA_ARGS__, 3); break; case 4: function(__VA_ARGS__, 4); break; case 5: function(__VA_ARGS__, 5); break; \
+        case 6: function(__VA_ARGS__, 6); break; case 7: function(__VA_ARGS__, 7); break; case 8: function(__VA_ARGS__, 8); break; \
+        case 9: function(__VA_ARGS__, 9); break; case 10: function(__VA_ARGS__, 10); break; case 11: function(__VA_ARGS__, 11); break; \
+        case 12: function(__VA_ARGS__, 12); break; case 13: function(__VA_ARGS__, 13); break; case 14: function(__VA_ARGS__, 14); break; \
+        case 15: function(__VA_ARGS__, 15); break; case 16: function(__VA_ARGS__, 16); break; case 17: function(__VA_ARGS__, 17); break; \
+        case 18: function(__VA_ARGS__, 18); break; case 19: function(__VA_ARGS__, 19); break; case 20: function(__VA_ARGS__, 20); break; \
+        case 21: function(__VA_ARGS__, 21); break; case 22: function(__VA_ARGS__, 22); break; case 23: function(__VA_ARGS__, 23); break; \
+        case 24: function(__VA_ARGS__, 24); break; case 25: function(__VA_ARGS__, 25); break; case 26: function(__VA_ARGS__, 26); break; \
+        case 27: function(__VA_ARGS__, 27); break; case 28: function(__VA_ARGS__, 28); break; case 29: function(__VA_ARGS__, 29); break; \
+        case 30: function(__VA_ARGS__, 30); break; case 31: function(__VA_ARGS__, 31); break; default: function(__VA_ARGS__, 32); break; \
+    }
+
+static inline unsigned flamey_bitsneeded(uint32_t value)
+{
+    return value == 0 ? 0 : 32 - __builtin_clz(value);
+}
+
+FLAMEY_DEF size_t flamey_packone
 (
-    const void* a,
-    const void* b
+    const int* values,
+    size_t count,
+    uint8_t* dest
 )
 {
-    return *(typeof(a)*) a - *(typeof(b)*) b;
+    flamey_packblock block = { FLAMEY_PACK_FOR, 0, (uint16_t) count, values[0], values[0], 0, 0 };
+    uint32_t residuals[FLAMEY_PACK_BLOCK], deltas[FLAMEY_PACK_BLOCK];
+    bool ascending = true;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        block.min = values[i] < block.min ? values[i] : block.min;
+        block.max = values[i] > block.max ? values[i] : block.max;
+        block.sum += values[i];
+
+        if (i > 0 && values[i] < values[i - 1]) ascending = false;
+    }
+
+    uint32_t widest = 0, widestdelta = 0;
+    size_t varint = 0;
+
+    for (size_t i = 0; i < FLAMEY_PACK_BLOCK; i++)
+    {
+        residuals[i] = i < count ? (uint32_t) values[i] - (uint32_t) block.min : 0;
+        widest |= residuals[i];
+        varint += i < count ? (size_t) (flamey_bitsneeded(residuals[i]) + 6) / 7 + (residuals[i] == 0) : 0;
+    }
+
+    if (ascending)
+    {
+        for (size_t i = 0; i < FLAMEY_PACK_BLOCK; i++)
+        {
+            uint32_t value = (uint32_t) values[i < count ? i : count - 1];
+            uint32_t before = i < 4 ? (uint32_t) block.min : (uint32_t) values[i - 4 < count ? i - 4 : count - 1];
+
+            deltas[i] = value - before;
+            widestdelta |= deltas[i];
+        }
+    }
+
+    unsigned bits = flamey_bitsneeded(widest);
+    const uint32_t* source = residuals;
+
+    if (ascending && flamey_bitsneeded(widestdelta) < bits)
+    {
+        block.mode = FLAMEY_PACK_DELTA;
+        bits = flamey_bitsneeded(widestdelta);
+        source = deltas;
+    }
+
+    uint8_t* payload = dest + sizeof(block);
+
+    if (4 * varint < 3 * 16 * (size_t) bits)
+    {
+        block.mode = FLAMEY_PACK_VARINT;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t value = residuals[i];
+
+            while (value >= 128)
+            {
+                payload[block.size++] = (uint8_t) (value | 128);
+                value >>= 7;
+            }
+
+            payload[block.size++] = (uint8_t) value;
+        }
+    }
+    else
+    {
+        block.bits = bits;
+        block.size = 16 * bits;
+        flamey_packcases(flamey_packbits, source, payload);
+    }
+
+    memcpy(dest, &block, sizeof(block));
+
+    return sizeof(block) + block.size;
 }
 
-/**
-    * @brief Comparison function for sorting an array in descending order.
-    * 
-    * @param a The first element to compare.
-    * @param b The second element to compare.
-    * 
-    * @return The difference between the two elements.
+FLAMEY_DEF const uint8_t* flamey_unpackone
+(
+    const uint8_t* packed,
+    int* dest,
+    flamey_packblock* block
+)
+{
+    uint32_t buffer[FLAMEY_PACK_BLOCK];
+
+    memcpy(block, packed, sizeof(*block));
+    packed += sizeof(*block);
+
+    if (block->mode == FLAMEY_PACK_VARINT)
+    {
+        const uint8_t* byte = packed;
+
+        for (size_t i = 0; i < block->count; i++)
+        {
+            uint32_t value = 0;
+
+            for (unsigned shift = 0; ; shift += 7)
+            {
+                value |= (uint32_t) (*byte & 127) << shift;
+
+                if (*byte++ < 128) break;
+            }
+
+            dest[i] = (int) (value + (uint32_t) block->min);
+        }
+
+        return packed + block->size;
+    }
+
+    uint32_t* values = block->count == FLAMEY_PACK_BLOCK ? (uint32_t*) dest : buffer;
+    unsigned bits = block->bits;
+    flamey_vec_pack sum = (flamey_vec_pack) { 0 } + (uint32_t) block->min;
+
+    flamey_packcases(flamey_unpackbits, packed, values);
+
+    for (size_t j = 0; j < FLAMEY_PACK_BLOCK / 4; j++)
+    {
+        flamey_vec_pack value;
+
+        memcpy(&value, &values[4 * j], sizeof(value));
+
+        if (block->mode == FLAMEY_PACK_DELTA) value = sum += value;
+        else value += sum;
+
+        memcpy(&values[4 * j], &value, sizeof(value));
+    }
+
+    if (values == buffer) memcpy(dest, buffer, block->count * sizeof(int));
+
+    return packed + block->size;
+}
+
+FLAMEY_DEF size_t intpack_bound
+(
+    size_t count
+)
+{
+    size_t blocks = (count + FLAMEY_PACK_BLOCK - 1) / FLAMEY_PACK_BLOCK;
+
+    return sizeof(flamey_packheader) + blocks * (sizeof(flamey_packblock) + FLAMEY_PACK_BLOCK * sizeof(uint32_t));
+}
+
+FLAMEY_DEF size_t intpack
+(
+    const int array[],
+    size_t start,
+    size_t end,
+    void* dest
+)
+{
+    if (!arrcheck(array, start, end, "intpack")) return 0;
+
+    flamey_packheader header = { FLAMEY_PACK_MAGIC, FLAMEY_PACK_BLOCK, end - start + 1 };
+    uint8_t* bytes = dest;
+    size_t written = sizeof(header);
+
+    memcpy(bytes, &header, sizeof(header));
+
+    for (size_t first = start; first <= end; first += FLAMEY_PACK_BLOCK)
+    {
+        size_t count = end - first + 1 < FLAMEY_PACK_BLOCK ? end - first + 1 : FLAMEY_PACK_BLOCK;
+
+        written += flamey_packone(&array[first], count, bytes + written);
+
+        if (count < FLAMEY_PACK_BLOCK) break;
+    }
+
+    return written;
+}
+
+FLAMEY_DEF size_t intpack_count
+(
+    const void* packed
+)
+{
+    flamey_packheader header;
+
+    if (packed == nullptr) return 0;
+
+    memcpy(&header, packed, sizeof(header));
+
+    return header.magic == FLAMEY_PACK_MAGIC && header.block == FLAMEY_PACK_BLOCK ? header.count : 0;
+}
+
+FLAMEY_DEF size_t intunpack
+(
+    const void* packed,
+    int dest[]
+)
+{
+    size_t count = intpack_count(packed);
+    const uint8_t* bytes = (const uint8_t*) packed + sizeof(flamey_packheader);
+    flamey_packblock block;
+
+    for (size_t first = 0; first < count; first += FLAMEY_PACK_BLOCK)
+    {
+        bytes = flamey_unpackone(bytes, &dest[first], &block);
+    }
+
+    return count;
+}
+
+FLAMEY_DEF bool flamey_packreduce
+(
+    const void* packed,
+    size_t start,
+    size_t end,
+    const char* funcname,
+    int* min,
+    int* max,
+    long long* sum
+)
+{
+    size_t count = intpack_count(packed);
+
+    if (!arrcheck(packed, start, end, funcname)) return false;
+    if (FLAMEY_RUNTIME_CHECKS && __builtin_expect(end >= count, 0) && validarrfail(FLAMEY_EBOUNDS, count, end, funcname) != FLAMEY_OK) return false;
+
+    const uint8_t* bytes = (const uint8_t*) packed + sizeof(flamey_packheader);
+    int values[FLAMEY_PACK_BLOCK];
+    flamey_packblock block;
+
+    *min = INT_MAX;
+    *max = INT_MIN;
+    *sum = 0;
+
+    for (size_t first = 0; first <= end; first += FLAMEY_PACK_BLOCK)
+    {
+        memcpy(&block, bytes, sizeof(block));
+
+        if (first + block.count <= start)
+        {
+            bytes += sizeof(block) + block.size;
+            continue;
+        }
+
+        if (first >= start && first + block.count - 1 <= end)
+        {
+            *min = block.min < *min ? block.min : *min;
+            *max = block.max > *max ? block.max : *max;
+            *sum += block.sum;
+            bytes += sizeof(block) + block.size;
+            continue;
+        }
+
+        bytes = flamey_unpackone(bytes, values, &block);
+
+        for (size_t i = first < start ? start - first : 0; i < block.count && first + i <= end; i++)
+        {
+            *min = values[i] < *min ? values[i] : *min;
+            *max = values[i] > *max ? values[i] : *max;
+            *sum += values[i];
+        }
+    }
+
+    return true;
+}
+
+FLAMEY_DEF int intpack_min
+(
+    const void* packed,
+    size_t start,
+    size_t end
+)
+{
+    int min, max;
+    long long sum;
+
+    return flamey_packreduce(packed, start, end, "intpack_min", &min, &max, &sum) ? min : 0;
+}
+
+FLAMEY_DEF int intpack_max
+(
+    const void* packed,
+    size_t start,
+    size_t end
+)
+{
+    int min, max;
+    long long sum;
+
+    return flamey_packreduce(packed, start, end, "intpack_max", &min, &max, &sum) ? max : 0;
+}
+
+FLAMEY_DEF long double intpack_average
+(
+    const void* packed,
+    size_t start,
+    size_t end
+)
+{
+    int min, max;
+    long long sum;
+
+    return flamey_packreduce(packed, start, end, "intpack_average", &min, &max, &sum) ? (long double) sum / (end - start + 1) : 0;
+}
+
+/*
+    BITSETS
 */
-int descending
+
+typedef uint64_t flamey_vec_bits __attribute__((vector_size(16)));
+
+FLAMEY_DEF size_t flamey_popcount(const uint64_t* words, size_t count)
+{
+    size_t total = 0;
+    size_t i = 0;
+
+#if !defined(__POPCNT__)
+    while (count - i >= 2)
+    {
+        flamey_vec_bits bytes = { 0 };
+
+        for (size_t stop = i + 62; i < stop && count - i >= 2; i += 2)
+        {
+            flamey_vec_bits x;
+
+            memcpy(&x, &words[i], sizeof(x));
+            x = x - ((x >> 1) & 0x5555555555555555);
+            x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+            bytes += (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+        }
+
+        flamey_vec_bits pairs = (bytes & 0x00ff00ff00ff00ff) + ((bytes >> 8) & 0x00ff00ff00ff00ff);
+
+        pairs = (pairs * 0x0001000100010001) >> 48;
+        total += pairs[0] + pairs[1];
+    }
+#endif
+
+    for (; i < count; i++) total += __builtin_popcountll(words[i]);
+
+    return total;
+}
+
+static inline unsigned int flamey_selectword(uint64_t word, size_t rank)
+{
+    unsigned int shift = 0;
+
+    for (size_t bits = __builtin_popcountll(word & 0xff); rank >= bits; bits = __builtin_popcountll(word & 0xff))
+    {
+        rank -= bits;
+        word >>= 8;
+        shift += 8;
+    }
+
+    for (; rank > 0; rank--) word &= word - 1;
+
+    return shift + __builtin_ctzll(word);
+}
+
+FLAMEY_DEF void bitset_init
 (
-    const void* a,
-    const void* b
+    bitset* set,
+    size_t length
+)
+{
+    set->words = calloc((length + 63) / 64, sizeof(uint64_t));
+    set->length = length;
+
+    if (set->words == nullptr && length > 0)
+    {
+        fprintf(stderr, "bitset_init(): not enough memory for %zu bits.\n", length);
+        exit(EXIT_FAILURE);
+    }
+}
+
+FLAMEY_DEF void bitset_free
+(
+    bitset* set
+)
+{
+    free(set->words);
+    set->words = nullptr;
+    set->length = 0;
+}
+
+FLAMEY_DEF void bitset_frombools
+(
+    bitset* set,
+    const bool array[],
+    size_t start,
+    size_t end
+)
+{
+    if (!arrcheck(array, start, end, "bitset_frombools") || !flamey_bitcheck(set, end - start, "bitset_frombools")) return;
+
+    const unsigned char* flags = (const unsigned char*) &array[start];
+    size_t count = end - start + 1;
+    size_t word = 0;
+
+    for (; count - 64 * word >= 64; word++) set->words[word] = flamey_packflags(&flags[64 * word]);
+
+    if (64 * word < count)
+    {
+        unsigned char rest[64] = { 0 };
+
+        memcpy(rest, &flags[64 * word], count - 64 * word);
+        set->words[word++] = flamey_packflags(rest);
+    }
+
+    memset(&set->words[word], 0, ((set->length + 63) / 64 - word) * sizeof(uint64_t));
+}
+
+FLAMEY_DEF size_t bitset_count
+(
+    const bitset* set
+)
+{
+    return flamey_popcount(set->words, (set->length + 63) / 64);
+}
+
+FLAMEY_DEF size_t bitset_rank
+(
+    const bitset* set,
+    size_t index
+)
+{
+    if (index > 0 && !flamey_bitcheck(set, index - 1, "bitset_rank")) return 0;
+
+    size_t rank = flamey_popcount(set->words, index / 64);
+
+    if (index % 64 != 0) rank += __builtin_popcountll(set->words[index / 64] & (((uint64_t) 1 << (index % 64)) - 1));
+
+    return rank;
+}
+
+FLAMEY_DEF size_t bitset_select
+(
+    const bitset* set,
+    size_t rank
+)
+{
+    size_t words = (set->length + 63) / 64;
+    size_t w = 0;
+
+    for (; words - w >= 8; w += 8)
+    {
+        size_t bits = flamey_popcount(&set->words[w], 8);
+
+        if (rank < bits) break;
+
+        rank -= bits;
+    }
+
+    for (; w < words; w++)
+    {
+        size_t bits = __builtin_popcountll(set->words[w]);
+
+        if (rank < bits) return 64 * w + flamey_selectword(set->words[w], rank);
+
+        rank -= bits;
+    }
+
+    return npos;
+}
+
+#define flamey_bitsetop(name, operation) \
+    FLAMEY_DEF void name \
+    ( \
+        bitset* dest, \
+        const bitset* first, \
+        const bitset* second \
+    ) \
+    { \
+        if (dest->length == 0 || !flamey_bitcheck(first, dest->length - 1, #name) || !flamey_bitcheck(second, dest->length - 1, #name)) return; \
+        \
+        size_t words = (dest->length + 63) / 64; \
+        \
+        for (size_t w = 0; w < words; w++) \
+        { \
+            uint64_t a = first->words[w]; \
+            uint64_t b = second->words[w]; \
+            \
+            dest->words[w] = operation; \
+        } \
+        \
+        if (dest->length % 64 != 0) dest->words[words - 1] &= ((uint64_t) 1 << (dest->length % 64)) - 1; \
+    }
+
+flamey_bitsetop(bitset_and, a & b)
+flamey_bitsetop(bitset_or, a | b)
+flamey_bitsetop(bitset_xor, a ^ b)
+flamey_bitsetop(bitset_andnot, a & ~b)
+
+FLAMEY_DEF void bitset_not
+(
+    bitset* dest,
+    const bitset* set
 )
 {
-    return *(typeof(b)*) b - *(typeof(a)*) a;
-}
\ No newline at end of file
+    if (dest->length == 0 || !flamey_bitcheck(set, dest->length - 1, "bitset_not")) return;
+
+    size_t words = (dest->length + 63) / 64;
+
+    for (size_t w = 0; w < words; w++) dest->words[w] = ~set->words[w];
+
+    if (dest->length % 64 != 0) dest->words[words - 1] &= ((uint64_t) 1 << (dest->length % 64)) - 1;
+}
+
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,639 @@
+/**
+    * @file flameystat.c
+    * @brief Reads numbers from files or from the standard input, and prints statistics about them, or prints them sorted.
+    *           A faster replacement for `sort -n | awk` pipelines. Run `flameystat -h` for the options.
+*/
+
+#include "flameysutils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define FLAMEYSTAT_BLOCK 1048576
+#define FLAMEYSTAT_PARALLEL 8388608
+
+/**
+    * @brief Statistics of a part of the numbers. Two of them can be merged, so each thread can have its own.
+*/
+typedef struct flameystat_stats
+{
+    size_t count;
+    size_t skipped;
+    double sum;
+    double mean;
+    double m2;
+    double min;
+    double max;
+} flameystat_stats;
+
+/**
+    * @brief A growing array of numbers, used when they must be kept (sorting, median, top-k).
+*/
+typedef struct flameystat_values
+{
+    double* items;
+    size_t count;
+    size_t capacity;
+} flameystat_values;
+
+/**
+    * @brief What the user asked for.
+*/
+typedef struct flameystat_options
+{
+    bool sort;
+    bool unique;
+    bool reverse;
+    bool median;
+    size_t top;
+} flameystat_options;
+
+/**
+    * @brief One part of a memory-mapped file, parsed by one thread.
+*/
+typedef struct flameystat_chunk
+{
+    const char* start;
+    const char* end;
+    flameystat_stats stats;
+    flameystat_values values;
+} flameystat_chunk;
+
+typedef struct flameystat_job
+{
+    flameystat_chunk* chunks;
+    const flameystat_options* options;
+} flameystat_job;
+
+static const double flameystat_powers[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+    * @brief Checks if a character separates numbers.
+*/
+static inline bool flameystat_separator
+(
+    char c
+)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ';' || c == '\v' || c == '\f';
+}
+
+/**
+    * @brief Parses a number. Numbers with up to 15 significant digits and a small exponent are parsed directly, which gives the same result as `strtod()`;
+    *           the others are given to `strtod()`.
+    *
+    * @param start The first character of the number.
+    * @param end The character after the last character of the number.
+    * @param value Where to put the number.
+    *
+    * @return `true` if the whole token is a number.
+*/
+static bool flameystat_parse
+(
+    const char* start,
+    const char* end,
+    double* value
+)
+{
+    const char* c = start;
+    bool negative = false;
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+
+    if (c < end && (*c == '-' || *c == '+')) negative = *c++ == '-';
+
+    const char* first = c;
+
+    for (; c < end && *c >= '0' && *c <= '9'; c++)
+    {
+        if (mantissa == 0 && *c == '0') continue;
+        if (digits++ < 19) mantissa = mantissa * 10 + (uint64_t) (*c - '0');
+        else exponent++;
+    }
+
+    if (c < end && *c == '.')
+    {
+        for (c++; c < end && *c >= '0' && *c <= '9'; c++)
+        {
+            if (mantissa == 0 && *c == '0')
+            {
+                exponent--;
+                continue;
+            }
+
+            if (digits++ < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t) (*c - '0');
+                exponent--;
+            }
+        }
+    }
+
+    bool fast = c > first && !(c == first + 1 && *first == '.');
+
+    if (fast && c < end && (*c == 'e' || *c == 'E'))
+    {
+        int sign = 1, power = 0;
+
+        c++;
+        if (c < end && (*c == '-' || *c == '+')) sign = *c++ == '-' ? -1 : 1;
+        if (c == end || *c < '0' || *c > '9') fast = false;
+
+        for (; c < end && *c >= '0' && *c <= '9'; c++)
+        {
+            if (power < 100000) power = power * 10 + (*c - '0');
+        }
+
+        exponent += sign * power;
+    }
+
+    if (fast && c == end && digits <= 15 && exponent >= -22 && exponent <= 22)
+    {
+        double number = (double) mantissa;
+
+        number = exponent < 0 ? number / flameystat_powers[-exponent] : number * flameystat_powers[exponent];
+        *value = negative ? -number : number;
+
+        return true;
+    }
+
+    char buffer[512];
+    size_t length = (size_t) (end - start);
+
+    if (length >= sizeof(buffer)) return false;
+
+    memcpy(buffer, start, length);
+    buffer[length] = '\0';
+
+    char* stop;
+
+    *value = strtod(buffer, &stop);
+
+    return length > 0 && stop == buffer + length;
+}
+
+static void flameystat_push
+(
+    flameystat_values* values,
+    double value
+)
+{
+    if (values->count == values->capacity)
+    {
+        values->capacity = values->capacity ? 2 * values->capacity : 4096;
+        values->items = realloc(values->items, values->capacity * sizeof(double));
+
+        if (values->items == nullptr)
+        {
+            fprintf(stderr, "flameystat: not enough memory to keep %zu numbers.\n", values->count);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    values->items[values->count++] = value;
+}
+
+/**
+    * @brief Adds a number to the statistics, with Welford's algorithm for the variance.
+*/
+static inline void flameystat_add
+(
+    flameystat_stats* stats,
+    double value
+)
+{
+    stats->count++;
+    stats->sum += value;
+
+    double delta = value - stats->mean;
+
+    stats->mean += delta / (double) stats->count;
+    stats->m2 += delta * (value - stats->mean);
+
+    if (value < stats->min) stats->min = value;
+    if (value > stats->max) stats->max = value;
+}
+
+/**
+    * @brief Merges the statistics of two parts of the numbers (Chan's formula for the variance).
+*/
+static void flameystat_merge
+(
+    flameystat_stats* into,
+    const flameystat_stats* from
+)
+{
+    into->skipped += from->skipped;
+
+    if (from->count == 0) return;
+
+    double count = (double) into->count + (double) from->count;
+    double delta = from->mean - into->mean;
+
+    into->m2 += from->m2 + delta * delta * (double) into->count * (double) from->count / count;
+    into->mean += delta * (double) from->count / count;
+    into->sum += from->sum;
+    into->count += from->count;
+
+    if (from->min < into->min) into->min = from->min;
+    if (from->max > into->max) into->max = from->max;
+}
+
+static void flameystat_reset
+(
+    flameystat_stats* stats
+)
+{
+    *stats = (flameystat_stats) { 0, 0, 0, 0, 0, INFINITY, -INFINITY };
+}
+
+/**
+    * @brief Keeps the `top` biggest numbers seen so far in a min-heap, so that memory stays bounded.
+*/
+static void flameystat_keeptop
+(
+    flameystat_values* heap,
+    size_t top,
+    double value
+)
+{
+    size_t i;
+
+    if (heap->count < top)
+    {
+        flameystat_push(heap, value);
+
+        for (i = heap->count - 1; i > 0 && heap->items[(i - 1) / 2] > heap->items[i]; i = (i - 1) / 2)
+        {
+            swap(&heap->items[i], &heap->items[(i - 1) / 2], sizeof(double));
+        }
+
+        return;
+    }
+
+    if (value <= heap->items[0]) return;
+
+    heap->items[0] = value;
+
+    for (i = 0; 2 * i + 1 < heap->count;)
+    {
+        size_t child = 2 * i + 1;
+
+        if (child + 1 < heap->count && heap->items[child + 1] < heap->items[child]) child++;
+        if (heap->items[i] <= heap->items[child]) break;
+
+        swap(&heap->items[i], &heap->items[child], sizeof(double));
+        i = child;
+    }
+}
+
+/**
+    * @brief Parses all the numbers between `start` and `end`, which must begin and end on a separator or the edges of the input.
+*/
+static void flameystat_scan
+(
+    const char* start,
+    const char* end,
+    const flameystat_options* options,
+    flameystat_stats* stats,
+    flameystat_values* values
+)
+{
+    bool keep = options->sort || options->unique || options->median;
+    const char* c = start;
+
+    while (c < end)
+    {
+        while (c < end && flameystat_separator(*c)) c++;
+
+        const char* token = c;
+
+        while (c < end && !flameystat_separator(*c)) c++;
+
+        if (token == c) break;
+
+        double value;
+
+        if (!flameystat_parse(token, c, &value))
+        {
+            stats->skipped++;
+            continue;
+        }
+
+        flameystat_add(stats, value);
+
+        if (options->top > 0) flameystat_keeptop(values, options->top, options->reverse ? -value : value);
+        else if (keep) flameystat_push(values, value);
+    }
+}
+
+static void flameystat_scanchunks
+(
+    size_t first,
+    size_t last,
+    void* data
+)
+{
+    flameystat_job* job = data;
+
+    for (size_t i = first; i <= last; i++)
+    {
+        flameystat_chunk* chunk = &job->chunks[i];
+
+        flameystat_scan(chunk->start, chunk->end, job->options, &chunk->stats, &chunk->values);
+    }
+}
+
+/**
+    * @brief Adds what was found in one part of the input to the totals.
+*/
+static void flameystat_collect
+(
+    flameystat_stats* stats,
+    flameystat_values* values,
+    const flameystat_stats* partstats,
+    flameystat_values* partvalues,
+    const flameystat_options* options
+)
+{
+    flameystat_merge(stats, partstats);
+
+    for (size_t i = 0; i < partvalues->count; i++)
+    {
+        if (options->top > 0) flameystat_keeptop(values, options->top, partvalues->items[i]);
+        else flameystat_push(values, partvalues->items[i]);
+    }
+
+    free(partvalues->items);
+    *partvalues = (flameystat_values) { 0 };
+}
+
+/**
+    * @brief Reads a memory-mapped file. Big files are cut into parts at separators, and the parts are parsed by all the threads of the pool.
+*/
+static void flameystat_readmapped
+(
+    const char* data,
+    size_t size,
+    const flameystat_options* options,
+    flameystat_stats* stats,
+    flameystat_values* values
+)
+{
+    size_t parts = size < FLAMEYSTAT_PARALLEL ? 1 : 8 * parallel_threads();
+    flameystat_chunk* chunks = calloc(parts, sizeof(flameystat_chunk));
+
+    if (chunks == nullptr)
+    {
+        fprintf(stderr, "flameystat: not enough memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const char* start = data;
+
+    for (size_t i = 0; i < parts; i++)
+    {
+        const char* end = i == parts - 1 ? data + size : data + size / parts * (i + 1);
+
+        if (end < start) end = start;
+        while (end < data + size && !flameystat_separator(*end)) end++;
+
+        chunks[i].start = start;
+        chunks[i].end = end;
+        flameystat_reset(&chunks[i].stats);
+        start = end;
+    }
+
+    flameystat_job job = { chunks, options };
+
+    parallel_for(0, parts - 1, 1, flameystat_scanchunks, &job);
+
+    for (size_t i = 0; i < parts; i++)
+    {
+        flameystat_collect(stats, values, &chunks[i].stats, &chunks[i].values, options);
+    }
+
+    free(chunks);
+}
+
+/**
+    * @brief Reads a file or a pipe block by block. A number cut by the end of a block is moved to the start of the next one.
+*/
+static void flameystat_readstream
+(
+    int file,
+    const flameystat_options* options,
+    flameystat_stats* stats,
+    flameystat_values* values
+)
+{
+    char* buffer = malloc(FLAMEYSTAT_BLOCK);
+    size_t kept = 0;
+    ssize_t got;
+    flameystat_stats part;
+    flameystat_values partvalues = { 0 };
+
+    if (buffer == nullptr)
+    {
+        fprintf(stderr, "flameystat: not enough memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    flameystat_reset(&part);
+
+    while ((got = read(file, buffer + kept, FLAMEYSTAT_BLOCK - kept)) > 0 || (got < 0 && errno == EINTR))
+    {
+        if (got < 0) continue;
+
+        size_t filled = kept + (size_t) got;
+        size_t cut = filled;
+
+        while (cut > 0 && !flameystat_separator(buffer[cut - 1])) cut--;
+        if (cut == 0) cut = filled;
+
+        flameystat_scan(buffer, buffer + cut, options, &part, &partvalues);
+
+        kept = filled - cut;
+        memmove(buffer, buffer + cut, kept);
+    }
+
+    flameystat_scan(buffer, buffer + kept, options, &part, &partvalues);
+    flameystat_collect(stats, values, &part, &partvalues, options);
+    free(buffer);
+}
+
+static bool flameystat_read
+(
+    const char* path,
+    const flameystat_options* options,
+    flameystat_stats* stats,
+    flameystat_values* values
+)
+{
+    int file = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    struct stat info;
+
+    if (file < 0)
+    {
+        fprintf(stderr, "flameystat: %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    if (fstat(file, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        void* data = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (data != MAP_FAILED)
+        {
+            madvise(data, (size_t) info.st_size, MADV_SEQUENTIAL);
+            flameystat_readmapped(data, (size_t) info.st_size, options, stats, values);
+            munmap(data, (size_t) info.st_size);
+
+            if (file != STDIN_FILENO) close(file);
+
+            return true;
+        }
+    }
+
+    flameystat_readstream(file, options, stats, values);
+
+    if (file != STDIN_FILENO) close(file);
+
+    return true;
+}
+
+/**
+    * @brief Prints a number with as few digits as possible, without losing precision.
+*/
+static void flameystat_print
+(
+    const char* name,
+    double value
+)
+{
+    char text[32];
+
+    snprintf(text, sizeof(text), "%.15g", value);
+    if (strtod(text, nullptr) != value) snprintf(text, sizeof(text), "%.17g", value);
+
+    if (name != nullptr) printf("%s %s\n", name, text);
+    else puts(text);
+}
+
+static void flameystat_usage(FILE* stream)
+{
+    fputs(
+        "Usage: flameystat [options] [file...]\n"
+        "Reads numbers (separated by spaces, new lines, commas or semicolons) from the files, or from the standard input\n"
+        "if there are none or a file is -, and prints their count, sum, mean, min, max and standard deviation.\n"
+        "Tokens that aren't numbers are skipped and counted.\n"
+        "\n"
+        "Options:\n"
+        "  -m      Also print the median (keeps all the numbers in memory).\n"
+        "  -s      Print the numbers sorted, one per line, instead of the statistics.\n"
+        "  -u      Same as -s, but prints each number once.\n"
+        "  -k N    Print the N biggest numbers, sorted, instead of the statistics (keeps only N numbers in memory).\n"
+        "  -r      Sort in descending order (with -k, print the N smallest numbers).\n"
+        "  -t N    Use N threads for big files (default: one per CPU, or FLAMEY_THREADS).\n"
+        "  -h      Print this help.\n",
+        stream);
+}
+
+int main(int argc, char** argv)
+{
+    flameystat_options options = { 0 };
+    int option;
+
+    while ((option = getopt(argc, argv, "msuk:rt:h")) != -1)
+    {
+        switch (option)
+        {
+            case 'm': options.median = true; break;
+            case 's': options.sort = true; break;
+            case 'u': options.sort = options.unique = true; break;
+            case 'r': options.reverse = true; break;
+            case 'k':
+                options.top = strtoull(optarg, nullptr, 10);
+
+                if (options.top == 0)
+                {
+                    fprintf(stderr, "flameystat: -k needs a number bigger than 0.\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 't': setenv("FLAMEY_THREADS", optarg, 1); break;
+            case 'h': flameystat_usage(stdout); return EXIT_SUCCESS;
+            default: flameystat_usage(stderr); return EXIT_FAILURE;
+        }
+    }
+
+    flameystat_stats stats;
+    flameystat_values values = { 0 };
+    bool ok = true;
+
+    flameystat_reset(&stats);
+
+    if (optind == argc) ok = flameystat_read("-", &options, &stats, &values);
+
+    for (int i = optind; i < argc; i++)
+    {
+        ok = flameystat_read(argv[i], &options, &stats, &values) && ok;
+    }
+
+    if (options.top > 0 || options.sort)
+    {
+        if (values.count > 0)
+        {
+            size_t last = values.count - 1;
+
+            if (options.top > 0 && options.reverse)
+            {
+                for (size_t i = 0; i <= last; i++) values.items[i] = -values.items[i];
+            }
+
+            if (options.reverse != (options.top > 0)) qsort(values.items, 0, last, double_descending);
+            else qsort(values.items, 0, last, double_ascending);
+
+            if (options.unique) last = unique(values.items, 0, last, double_ascending);
+
+            for (size_t i = 0; i <= last; i++) flameystat_print(nullptr, values.items[i]);
+        }
+    }
+    else
+    {
+        printf("count %zu\n", stats.count);
+
+        if (stats.count > 0)
+        {
+            flameystat_print("sum", stats.sum);
+            flameystat_print("mean", stats.mean);
+            flameystat_print("min", stats.min);
+            flameystat_print("max", stats.max);
+            flameystat_print("stddev", stats.count > 1 ? sqrt(stats.m2 / (double) (stats.count - 1)) : 0);
+
+            if (options.median)
+            {
+                qsort(values.items, 0, values.count - 1, double_ascending);
+
+                double median = values.items[values.count / 2];
+
+                if (values.count % 2 == 0) median = (median + values.items[values.count / 2 - 1]) / 2;
+
+                flameystat_print("median", median);
+            }
+        }
+
+        if (stats.skipped > 0) printf("skipped %zu\n", stats.skipped);
+    }
+
+    free(values.items);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
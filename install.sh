@@ -9,6 +9,8 @@ LANG=0
 
 echo -e "Please select the language you want to install \033[1;34mflameysutils\033[0m for:"
 echo -e "0. \033[0;34mC\033[0m (\033[1;34mflameysutils.h\033[0m to \033[0;32m/usr/include\033[0m)"
+echo -e "1. \033[0;34mC library\033[0m (\033[1;34mflameysutils.h\033[0m to \033[0;32m/usr/include\033[0m, \033[1;34mlibflameysutils\033[0m to \033[0;32m/usr/lib\033[0m, \033[1;34mflameysutils.pc\033[0m to \033[0;32m/usr/lib/pkgconfig\033[0m)"
+echo -e "2. \033[0;34mflameystat\033[0m (command-line statistics tool, \033[1;34mflameystat\033[0m to \033[0;32m/usr/bin\033[0m)"
 
 printf "\n"
 
@@ -25,6 +27,35 @@ case $LANG in
             exit 1
         fi
         ;;
+    1)
+        if ! make -C "./c" PREFIX="/usr" all; then
+            echo -e "Failed to build \033[1;34mlibflameysutils\033[0m. Make sure \033[0;34mmake\033[0m and \033[0;34mgcc\033[0m are installed."
+            exit 1
+        fi
+
+        if cp "./c/flameysutils.h" "/usr/include/flameysutils.h" \
+            && cp "./c/build/libflameysutils.a" "./c/build/libflameysutils.so" "/usr/lib/" \
+            && mkdir -p "/usr/lib/pkgconfig" \
+            && cp "./c/build/flameysutils.pc" "/usr/lib/pkgconfig/flameysutils.pc"; then
+            echo -e "Successfully installed \033[1;34mlibflameysutils\033[0m. Compile with \033[0;34m\$(pkg-config --cflags --libs flameysutils)\033[0m."
+        else
+            echo -e "Failed to install \033[1;34mlibflameysutils\033[0m. Reason is unknown."
+            exit 1
+        fi
+        ;;
+    2)
+        if ! make -C "./c" flameystat; then
+            echo -e "Failed to build \033[1;34mflameystat\033[0m. Make sure \033[0;34mmake\033[0m and \033[0;34mgcc\033[0m are installed."
+            exit 1
+        fi
+
+        if cp "./c/build/flameystat" "/usr/bin/flameystat"; then
+            echo -e "Successfully installed \033[1;34mflameystat\033[0m to \033[0;32m/usr/bin\033[0m. Run \033[0;34mflameystat -h\033[0m to see how to use it."
+        else
+            echo -e "Failed to install \033[1;34mflameystat\033[0m. Reason is unknown."
+            exit 1
+        fi
+        ;;
     *)
         echo "Invalid selection."
         exit 1